@@ -0,0 +1,229 @@
+`default_nettype none
+`timescale 1ns / 1ns
+
+/**
+ * @brief Testbench für seq_divider mit Zyklenzählung.
+ *
+ * Prüft vorzeichenlose und vorzeichenbehaftete Divisionen (Randfälle und
+ * Zufallswerte) gegen die Verilog-Operatoren und vergleicht die gezählten
+ * busy-Takte mit dem Latenzregister und der erwarteten Latenz
+ * 2 + ceil(Quotientenbits / 2). Am Ende werden Fehlerzahl sowie minimale,
+ * mittlere und maximale Latenz ausgegeben.
+ *
+ * Erwartete Ausgabe von `run.bat -div`: 4030 Fälle, 0 Fehler, Latenz
+ * minimal 2 (0 / 1) und maximal 18 (0xFFFFFFFF / 1), im Mittel etwa 4.
+ */
+
+module seq_divider_tb ();
+
+  localparam INFO_OFFSET = 8'h00;
+  localparam END_OFFSET  = 8'h04;
+  localparam SOR_OFFSET  = 8'h08;
+  localparam QUO_OFFSET  = 8'h0C;
+  localparam REM_OFFSET  = 8'h10;
+  localparam SSOR_OFFSET = 8'h14;
+  localparam LAT_OFFSET  = 8'h18;
+
+  localparam RANDOM_CASES = 2000;
+
+  reg         tb_clk;
+  reg         tb_rst_n;
+  reg  [ 7:0] tb_address;
+  reg  [31:0] tb_write_data;
+  reg         tb_we;
+  reg         tb_re;
+
+  wire [31:0] tb_read_data;
+
+  seq_divider dut (
+    .clk        (tb_clk),
+    .rst_n      (tb_rst_n),
+    .address    (tb_address),
+    .write_data (tb_write_data),
+    .read_data  (tb_read_data),
+    .we         (tb_we),
+    .re         (tb_re)
+  );
+
+  integer errors;
+  integer cases;
+  integer total_cycles;
+  integer min_cycles;
+  integer max_cycles;
+  integer i;
+
+  initial
+  begin
+    tb_clk = 0;
+    forever #50 tb_clk = ~tb_clk;
+  end
+
+  task bus_write(input [7:0] addr, input [31:0] data);
+    begin
+      @(negedge tb_clk);
+      tb_address    = addr;
+      tb_write_data = data;
+      tb_we         = 1'b1;
+      @(negedge tb_clk);
+      tb_we         = 1'b0;
+    end
+  endtask
+
+  task bus_read(input [7:0] addr, output [31:0] data);
+    begin
+      @(negedge tb_clk);
+      tb_address = addr;
+      tb_re      = 1'b1;
+      #1;
+      data       = tb_read_data;
+      tb_re      = 1'b0;
+    end
+  endtask
+
+  // Erwartete Latenz: 2 Takte plus ein Takt pro zwei Quotientenbits
+  function integer expected_cycles(input [31:0] n, input [31:0] d);
+    integer nlz_n;
+    integer nlz_d;
+    integer k;
+    begin
+      nlz_n = 32;
+      nlz_d = 32;
+      for (k = 0; k < 32; k = k + 1)
+      begin
+        if (n[k]) nlz_n = 31 - k;
+        if (d[k]) nlz_d = 31 - k;
+      end
+
+      if (d == 32'd0 || n < d)
+        expected_cycles = 2;
+      else
+        expected_cycles = 2 + (nlz_d - nlz_n + 2) / 2;
+    end
+  endfunction
+
+  task check_div(input [31:0] n, input [31:0] d, input sign);
+    reg [31:0] quo;
+    reg [31:0] rem;
+    reg [31:0] lat;
+    reg [31:0] exp_quo;
+    reg [31:0] exp_rem;
+    reg [31:0] abs_n;
+    reg [31:0] abs_d;
+    integer    busy_cycles;
+    integer    exp_cycles;
+    begin
+      abs_n = (sign && n[31]) ? -n : n;
+      abs_d = (sign && d[31]) ? -d : d;
+
+      if (d == 32'd0)
+      begin
+        exp_quo = 32'hFFFFFFFF;
+        exp_rem = n;
+      end
+      else if (sign && n == 32'h80000000 && d == 32'hFFFFFFFF)
+      begin
+        // Überlauf: -2^31 / -1
+        exp_quo = 32'h80000000;
+        exp_rem = 32'd0;
+      end
+      else if (sign)
+      begin
+        exp_quo = $signed(n) / $signed(d);
+        exp_rem = $signed(n) % $signed(d);
+      end
+      else
+      begin
+        exp_quo = n / d;
+        exp_rem = n % d;
+      end
+
+      exp_cycles = expected_cycles(abs_n, abs_d);
+
+      bus_write(END_OFFSET, n);
+
+      // Start, busy wird mit der Schreibflanke gesetzt
+      @(negedge tb_clk);
+      tb_address    = sign ? SSOR_OFFSET : SOR_OFFSET;
+      tb_write_data = d;
+      tb_we         = 1'b1;
+      @(negedge tb_clk);
+      tb_we         = 1'b0;
+      tb_address    = INFO_OFFSET;
+      busy_cycles   = 1;
+      #1;
+      while (tb_read_data[0])
+      begin
+        @(negedge tb_clk);
+        #1;
+        if (tb_read_data[0])
+          busy_cycles = busy_cycles + 1;
+      end
+
+      bus_read(QUO_OFFSET, quo);
+      bus_read(REM_OFFSET, rem);
+      bus_read(LAT_OFFSET, lat);
+
+      if (quo !== exp_quo || rem !== exp_rem || lat != busy_cycles || busy_cycles != exp_cycles)
+      begin
+        errors = errors + 1;
+        $display("FAIL %s %08X / %08X: q=%08X (%08X) r=%08X (%08X) cycles=%0d lat=%0d exp=%0d",
+                 sign ? "s" : "u", n, d, quo, exp_quo, rem, exp_rem, busy_cycles, lat, exp_cycles);
+      end
+
+      cases        = cases + 1;
+      total_cycles = total_cycles + busy_cycles;
+      if (busy_cycles < min_cycles) min_cycles = busy_cycles;
+      if (busy_cycles > max_cycles) max_cycles = busy_cycles;
+    end
+  endtask
+
+  task check_both(input [31:0] n, input [31:0] d);
+    begin
+      check_div(n, d, 1'b0);
+      check_div(n, d, 1'b1);
+    end
+  endtask
+
+  initial
+  begin
+    tb_rst_n      = 0;
+    tb_address    = 8'd0;
+    tb_write_data = 32'd0;
+    tb_we         = 1'b0;
+    tb_re         = 1'b0;
+    errors        = 0;
+    cases         = 0;
+    total_cycles  = 0;
+    min_cycles    = 1000;
+    max_cycles    = 0;
+
+    #500 tb_rst_n = 1;
+
+    // Randfälle
+    check_both(32'd0,          32'd1);
+    check_both(32'd1,          32'd1);
+    check_both(32'd100,        32'd7);
+    check_both(32'd6,          32'd7);
+    check_both(32'd12000000,   32'd10);
+    check_both(32'd12000000,   32'd1000);
+    check_both(32'hFFFFFFFF,   32'd1);
+    check_both(32'hFFFFFFFF,   32'hFFFFFFFF);
+    check_both(32'h80000000,   32'hFFFFFFFF);
+    check_both(32'h80000000,   32'd1);
+    check_both(32'h7FFFFFFF,   32'h80000000);
+    check_both(32'd1234,       32'd0);
+    check_both(32'hFFFFFF9C,   32'd7);
+    check_both(32'd100,        32'hFFFFFFF9);
+    check_both(32'hFFFFFF9C,   32'hFFFFFFF9);
+
+    // Zufallswerte mit zufälliger Bitbreite
+    for (i = 0; i < RANDOM_CASES; i = i + 1)
+      check_both($random >> ($random & 31), $random >> ($random & 31));
+
+    $display("seq_divider_tb: %0d cases, %0d errors", cases, errors);
+    $display("seq_divider_tb: cycles min %0d, avg %0d, max %0d",
+             min_cycles, total_cycles / cases, max_cycles);
+    $stop;
+  end
+
+endmodule
@@ -0,0 +1,196 @@
+`include "../../rtl/defines.v"
+`default_nettype none
+`timescale 1ns / 1ns
+
+/**
+ * @brief Testbench für seq_multiplier mit Zyklenzählung.
+ *
+ * Prüft Randfälle und Zufallswerte gegen den Verilog-Operator und vergleicht
+ * die gezählten busy-Takte mit der im Informationsregister gemeldeten
+ * maximalen Latenz und, mit `MULT_EARLY_OUT`, mit der erwarteten Latenz
+ * (Booth: floor(k / 2) + 1, sonst max(k, 1) mit k = Bitbreite des kleineren
+ * Operanden). Am Ende werden Fehlerzahl sowie minimale, mittlere und
+ * maximale Latenz ausgegeben.
+ *
+ * Erwartete Ausgabe von `run.bat -mult`: 2011 Fälle, 0 Fehler, Latenz
+ * 0 mit `MULT_DSP`, 1 bis 17 mit `MULT_BOOTH` und Early-Out, sonst 1 bis 32
+ * bzw. fest 17 oder 32 ohne Early-Out.
+ */
+
+module seq_multiplier_tb ();
+
+  localparam INFO_OFFSET = 8'h00;
+  localparam MUL1_OFFSET = 8'h04;
+  localparam MUL2_OFFSET = 8'h08;
+  localparam RESH_OFFSET = 8'h0C;
+  localparam RESL_OFFSET = 8'h10;
+
+  localparam RANDOM_CASES = 2000;
+
+  reg         tb_clk;
+  reg         tb_rst_n;
+  reg  [ 7:0] tb_address;
+  reg  [31:0] tb_write_data;
+  reg         tb_we;
+  reg         tb_re;
+
+  wire [31:0] tb_read_data;
+
+  seq_multiplier dut (
+    .clk        (tb_clk),
+    .rst_n      (tb_rst_n),
+    .address    (tb_address),
+    .write_data (tb_write_data),
+    .read_data  (tb_read_data),
+    .we         (tb_we),
+    .re         (tb_re)
+  );
+
+  integer errors;
+  integer cases;
+  integer total_cycles;
+  integer min_cycles;
+  integer max_cycles;
+  integer max_latency;
+  integer early_out;
+  integer i;
+
+  initial
+  begin
+    tb_clk = 0;
+    forever #50 tb_clk = ~tb_clk;
+  end
+
+  task bus_write(input [7:0] addr, input [31:0] data);
+    begin
+      @(negedge tb_clk);
+      tb_address    = addr;
+      tb_write_data = data;
+      tb_we         = 1'b1;
+      @(negedge tb_clk);
+      tb_we         = 1'b0;
+    end
+  endtask
+
+  task bus_read(input [7:0] addr, output [31:0] data);
+    begin
+      @(negedge tb_clk);
+      tb_address = addr;
+      tb_re      = 1'b1;
+      #1;
+      data       = tb_read_data;
+      tb_re      = 1'b0;
+    end
+  endtask
+
+  // Erwartete Latenz mit Early-Out, k = Bitbreite des kleineren Operanden
+  function integer expected_cycles(input [31:0] a, input [31:0] b);
+    reg [31:0] small;
+    integer    bits;
+    integer    k;
+    begin
+      small = (a < b) ? a : b;
+      bits  = 0;
+      for (k = 0; k < 32; k = k + 1)
+        if (small[k]) bits = k + 1;
+
+`ifdef MULT_BOOTH
+      expected_cycles = bits / 2 + 1;
+`else
+      expected_cycles = (bits == 0) ? 1 : bits;
+`endif
+    end
+  endfunction
+
+  task check_mult(input [31:0] a, input [31:0] b);
+    reg [31:0] res_h;
+    reg [31:0] res_l;
+    reg [63:0] exp_res;
+    integer    busy_cycles;
+    integer    exp_cycles;
+    begin
+      exp_res    = {32'd0, a} * {32'd0, b};
+      exp_cycles = early_out ? expected_cycles(a, b) : max_latency;
+
+      bus_write(MUL1_OFFSET, a);
+
+      // Start, busy wird mit der Schreibflanke gesetzt
+      @(negedge tb_clk);
+      tb_address    = MUL2_OFFSET;
+      tb_write_data = b;
+      tb_we         = 1'b1;
+      @(negedge tb_clk);
+      tb_we         = 1'b0;
+      tb_address    = INFO_OFFSET;
+      busy_cycles   = 0;
+      #1;
+      while (tb_read_data[0])
+      begin
+        busy_cycles = busy_cycles + 1;
+        @(negedge tb_clk);
+        #1;
+      end
+
+      bus_read(RESH_OFFSET, res_h);
+      bus_read(RESL_OFFSET, res_l);
+
+      if ({res_h, res_l} !== exp_res || busy_cycles > max_latency || busy_cycles != exp_cycles)
+      begin
+        errors = errors + 1;
+        $display("FAIL %08X * %08X: %08X%08X (%016X) cycles=%0d exp=%0d",
+                 a, b, res_h, res_l, exp_res, busy_cycles, exp_cycles);
+      end
+
+      cases        = cases + 1;
+      total_cycles = total_cycles + busy_cycles;
+      if (busy_cycles < min_cycles) min_cycles = busy_cycles;
+      if (busy_cycles > max_cycles) max_cycles = busy_cycles;
+    end
+  endtask
+
+  initial
+  begin
+    tb_rst_n      = 0;
+    tb_address    = 8'd0;
+    tb_write_data = 32'd0;
+    tb_we         = 1'b0;
+    tb_re         = 1'b0;
+    errors        = 0;
+    cases         = 0;
+    total_cycles  = 0;
+    min_cycles    = 1000;
+    max_cycles    = 0;
+
+    #500 tb_rst_n = 1;
+
+    // Informationsregister: Latenz und Early-Out
+    tb_address = INFO_OFFSET;
+    #1;
+    max_latency = tb_read_data[15:8];
+    early_out   = tb_read_data[16];
+    $display("seq_multiplier_tb: latency %0d, early-out %0d", max_latency, early_out);
+
+    // Randfälle
+    check_mult(32'd0,        32'd0);
+    check_mult(32'd1,        32'd1);
+    check_mult(32'd3,        32'd5);
+    check_mult(32'd12345,    32'd1000);
+    check_mult(32'hFFFFFFFF, 32'd0);
+    check_mult(32'd0,        32'hFFFFFFFF);
+    check_mult(32'hFFFFFFFF, 32'd1);
+    check_mult(32'hFFFFFFFF, 32'hFFFFFFFF);
+    check_mult(32'h80000000, 32'h80000000);
+    check_mult(32'hAAAAAAAA, 32'h55555555);
+    check_mult(32'h12345678, 32'hCCCCCCCD);
+
+    // Zufallswerte mit zufälliger Bitbreite
+    for (i = 0; i < RANDOM_CASES; i = i + 1)
+      check_mult($random >> ($random & 31), $random >> ($random & 31));
+
+    $display("seq_multiplier_tb: %0d cases, %0d errors", cases, errors);
+    $display("seq_multiplier_tb: cycles min %0d, avg %0d, max %0d",
+             min_cycles, total_cycles / cases, max_cycles);
+    $stop;
+  end
+
+endmodule
@@ -17,6 +17,8 @@
  *
  * Hier eine Kurzbeschreibung der Zustände:
  *  - FETCH  : Eine Instruktion wird über re=1 im Speicher angefordert.
+ *             Solange `bus_hold` gesetzt ist, verharrt die CPU hier und
+ *             überlässt den Bus einem anderen Master (DMA).
  *  - WAIT   : Auf das Eintreffen von read_data wird gewartet.
  *  - DECODE : Instruktionsbits (opcode, funct3, funct7, rs1, rs2, rd usw.) extrahieren.
  *  - EXECUTE: ALU-Operationen durchführen, Sprungadressen berechnen usw.
@@ -46,6 +48,8 @@
  * @output reg        we         Write-Enable
  * @output reg        re         Read-Enable
  * @input  wire       mem_busy   Signalisiert, ob der Speicherzugriff noch in Arbeit ist
+ * @input  wire       bus_hold   Anforderung eines anderen Bus-Masters, vor dem nächsten Fetch zu warten
+ * @output wire       bus_idle   CPU steht in FETCH und hat keinen offenen Speicherzugriff
  */
 
 module cpu (
@@ -56,7 +60,9 @@ module cpu (
   input  wire [31:0] read_data,
   output reg         we,
   output reg         re,
-  input  wire        mem_busy
+  input  wire        mem_busy,
+  input  wire        bus_hold,
+  output wire        bus_idle
 );
 
   // ---------------------------------------------------------
@@ -183,6 +189,9 @@ localparam [6:0]
   // ---------------------------------------------------------
   assign address = address_reg;
 
+  // Zwischen zwei Instruktionen ist kein Speicherzugriff offen
+  assign bus_idle = (state == FETCH);
+
   assign opcode = inst[ 6: 0];
   assign funct7 = inst[31:25];
   assign rs1    = inst[19:15];
@@ -270,7 +279,7 @@ localparam [6:0]
     case (state)
 
       FETCH:
-        next_state = WAIT;
+        next_state = bus_hold ? FETCH : WAIT;
 
       WAIT:
         next_state = (mem_busy || re) ? WAIT : DECODE;
@@ -356,8 +365,11 @@ localparam [6:0]
         // -------------------------------------------------
         FETCH:
         begin
-          re          <= 1'b1;
-          address_reg <= PC;
+          if (!bus_hold)
+          begin
+            re          <= 1'b1;
+            address_reg <= PC;
+          end
         end
 
         // -------------------------------------------------
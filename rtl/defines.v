@@ -64,5 +64,19 @@
 `define INCLUDE_SPI
 `define INCLUDE_GPIO
 `define INCLUDE_WS
+`define INCLUDE_DMA
+
+/**
+ * @brief Wählt die Implementierung von seq_multiplier.
+ *        MULT_DSP: Ein-Takt-Multiplikation über DSP-Blöcke (Quartus/FPGA).
+ *        MULT_BOOTH: Radix-4-Booth, 17 Takte (ASIC, geringe Fläche).
+ *        Ohne beide: ein Bit pro Takt, 32 Takte.
+ *        MULT_EARLY_OUT: Sequentielle Varianten enden, sobald der kleinere
+ *        Operand abgearbeitet ist.
+ * @parameter MULT_DSP, MULT_BOOTH, MULT_EARLY_OUT
+ */
+`define MULT_DSP
+//`define MULT_BOOTH
+`define MULT_EARLY_OUT
 
 `endif
@@ -13,6 +13,10 @@
  * Zugriffe im Peripheriebereich werden an das `peripheral_bus`
  * Modul weitergereicht.
  *
+ * Fordert der DMA-Controller den Bus an (`bus_hold`) und steht die
+ * CPU zwischen zwei Instruktionen (`bus_idle`), werden Adresse,
+ * Daten und Steuersignale stattdessen vom DMA übernommen.
+ *
  * Folgende Bereiche sind definiert:
  * - Adressen >= 0x00004000: RAM/FRAM-Bereich
  * - Adressen <  0x00004000: Peripherie-Bereich (per_addr)
@@ -25,6 +29,8 @@
  * @input  we         Write Enable
  * @input  re         Read Enable
  * @output mem_busy   Signalisiert, ob ein externer Zugriff (z. B. FRAM) noch busy ist
+ * @output bus_hold   Busanforderung des DMA an die CPU
+ * @input  bus_idle   CPU steht zwischen zwei Instruktionen (FETCH)
  *
  * @output uart_tx    UART-Ausgang
  * @input  uart_rx    UART-Eingang
@@ -49,6 +55,8 @@ module memory (
   output wire [31:0] read_data,
   input  wire        we,
   input  wire        re,
+  input  wire        bus_idle,
+  output wire        bus_hold,
   output wire        uart_tx,
   input  wire        uart_rx,
   output wire [31:0] debug_out,
@@ -80,24 +88,45 @@ module memory (
   wire re_per;
   wire req_ready;
 
+  // ---------------------------------------------------------
+  // Bus-Multiplexer zwischen CPU und DMA
+  // ---------------------------------------------------------
+  wire [31:0] dma_address;
+  wire [31:0] dma_write_data;
+  wire [31:0] bus_address;
+  wire [31:0] bus_write_data;
+  wire        dma_hold;
+  wire        dma_grant;
+  wire        dma_we;
+  wire        dma_re;
+  wire        bus_we;
+  wire        bus_re;
+
+  assign bus_hold       = dma_hold;
+  assign dma_grant      = dma_hold && bus_idle;
+  assign bus_address    = dma_grant ? dma_address    : address;
+  assign bus_write_data = dma_grant ? dma_write_data : write_data;
+  assign bus_we         = dma_grant ? dma_we         : we;
+  assign bus_re         = dma_grant ? dma_re         : re;
+
   // ---------------------------------------------------------
   // Lese-/Schreib-Steuerung
   // ---------------------------------------------------------
-  assign we_ram    = we &&  is_ram;
+  assign we_ram    = bus_we &&  is_ram;
 `ifdef FRAM_MEMORY
-  assign re_ram    = re &&  is_ram;
+  assign re_ram    = bus_re &&  is_ram;
 `endif
-  assign we_per    = we && !is_ram;
-  assign re_per    = re && !is_ram;
+  assign we_per    = bus_we && !is_ram;
+  assign re_per    = bus_re && !is_ram;
 
   // ---------------------------------------------------------
   // Aufteilung der Adressbereiche
-  // is_ram = 1, wenn address >= 0x00004000
-  // Ansonsten per_addr = address[13:0]
+  // is_ram = 1, wenn bus_address >= 0x00004000
+  // Ansonsten per_addr = bus_address[13:0]
   // ---------------------------------------------------------
-  assign is_ram    = (address >= 32'h00004000);
-  assign ram_addr  = (address  - 32'h00004000);
-  assign per_addr  = is_ram ? 14'b0 : address[13:0];
+  assign is_ram    = (bus_address >= 32'h00004000);
+  assign ram_addr  = (bus_address  - 32'h00004000);
+  assign per_addr  = is_ram ? 14'b0 : bus_address[13:0];
   assign read_data = is_ram ? ram_data : per_data;
 
   // ---------------------------------------------------------
@@ -118,7 +147,7 @@ module memory (
     .rst_n      (rst_n),
     .req_ready  (req_ready),
     .address    (ram_addr[15:0]),
-    .write_data (write_data),
+    .write_data (bus_write_data),
     .read_data  (ram_data),
     .we         (we_ram),
     .re         (re_ram),
@@ -132,7 +161,7 @@ module memory (
   ram1p ram1p_inst (
     .address (ram_addr[14:2]),
     .clock   (clk),
-    .data    (write_data),
+    .data    (bus_write_data),
     .wren    (we_ram),
     .q       (ram_data)
   );
@@ -145,7 +174,7 @@ module memory (
     .clk        (clk),
     .rst_n      (rst_n),
     .address    (per_addr),
-    .write_data (write_data),
+    .write_data (bus_write_data),
     .read_data  (per_data),
     .we         (we_per),
     .re         (re_per),
@@ -167,7 +196,15 @@ module memory (
 `endif
     .gpio_out   (gpio_out),
     .gpio_dir   (gpio_dir),
-    .gpio_in    (gpio_in)
+    .gpio_in    (gpio_in),
+    .dma_hold       (dma_hold),
+    .dma_grant      (dma_grant),
+    .mem_busy       (mem_busy),
+    .dma_address    (dma_address),
+    .dma_write_data (dma_write_data),
+    .dma_read_data  (read_data),
+    .dma_we         (dma_we),
+    .dma_re         (dma_re)
   );
 
 endmodule
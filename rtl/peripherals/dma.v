@@ -0,0 +1,323 @@
+`default_nettype none
+`timescale 1ns / 1ns
+
+/**
+ * @brief Einfacher DMA-Controller für Speicher-zu-Peripherie-Transfers.
+ *
+ * Der Controller kopiert `LEN` Elemente (Byte, Halbwort oder Wort) von
+ * `SRC` nach `DST`. Quelle und Ziel können jeweils inkrementiert werden
+ * oder fest bleiben (z. B. das TX-Register von UART oder SPI). Das Ziel
+ * wird immer als ganzes Wort geschrieben, kleinere Elemente werden
+ * rechtsbündig mit Nullen aufgefüllt.
+ *
+ * Der Bus wird der CPU zwischen zwei Instruktionen entzogen: `bus_hold`
+ * hält die CPU in FETCH, sobald `bus_grant` anliegt, führt der DMA genau
+ * ein Element (Lesen und Schreiben) aus und gibt den Bus danach für
+ * mindestens eine Instruktion wieder frei. Ist die gewählte Takt-Quelle
+ * (UART- oder SPI-TX-FIFO) voll, wird der Bus gar nicht erst angefordert.
+ * Bei Byte- und Halbwortquellen wird das gelesene Wort zwischengespeichert,
+ * sodass der Speicher nur einmal pro Wort gelesen wird.
+ *
+ * Register-Offsets:
+ * - `CTRL_OFFSET`   : Bit 0 Start/Busy, Bit 2:1 Elementgröße (0 = 8, 1 = 16,
+ *                     2 = 32 Bit), Bit 3 SRC inkrementieren, Bit 4 DST
+ *                     inkrementieren, Bit 6:5 Takt-Quelle (0 = keine,
+ *                     1 = UART TX, 2 = SPI TX). Schreiben von Bit 0 = 0 bricht
+ *                     einen laufenden Transfer am nächsten Element ab.
+ * - `SRC_OFFSET`    : Quelladresse
+ * - `DST_OFFSET`    : Zieladresse
+ * - `LEN_OFFSET`    : Anzahl der Elemente, liest die verbleibende Anzahl
+ * - `STATUS_OFFSET` : Bit 0 Busy, Bit 1 Fertig
+ *
+ * @localparam CTRL_OFFSET   Offset des Steuerregisters
+ * @localparam SRC_OFFSET    Offset der Quelladresse
+ * @localparam DST_OFFSET    Offset der Zieladresse
+ * @localparam LEN_OFFSET    Offset der Elementanzahl
+ * @localparam STATUS_OFFSET Offset des Statusregisters
+ *
+ * @input  clk               Systemtakt
+ * @input  rst_n             Asynchroner, aktiver-LOW Reset
+ * @input  [7:0] address     Registeroffset innerhalb des DMA-Moduls
+ * @input  [31:0] write_data Zu schreibende Daten
+ * @output [31:0] read_data  Gelesener Registerwert
+ * @input  we                Write-Enable
+ * @input  re                Read-Enable
+ * @input  uart_tx_full      UART-TX-FIFO voll
+ * @input  spi_tx_full       SPI-TX-FIFO voll
+ * @output bus_hold          Busanforderung an die CPU
+ * @input  bus_grant         Bus ist dem DMA zugeteilt
+ * @input  bus_busy          Speicherzugriff noch in Arbeit (mem_busy)
+ * @output [31:0] bus_address    Adresse des DMA-Zugriffs
+ * @output [31:0] bus_write_data Daten des DMA-Schreibzugriffs
+ * @input  [31:0] bus_read_data  Gelesene Daten des DMA-Lesezugriffs
+ * @output bus_we            Write-Enable des DMA-Zugriffs
+ * @output bus_re            Read-Enable des DMA-Zugriffs
+ */
+
+module dma (
+  input  wire        clk,
+  input  wire        rst_n,
+  input  wire [ 7:0] address,
+  input  wire [31:0] write_data,
+  output wire [31:0] read_data,
+  input  wire        we,
+  input  wire        re,
+  input  wire        uart_tx_full,
+  input  wire        spi_tx_full,
+  output reg         bus_hold,
+  input  wire        bus_grant,
+  input  wire        bus_busy,
+  output reg  [31:0] bus_address,
+  output reg  [31:0] bus_write_data,
+  input  wire [31:0] bus_read_data,
+  output reg         bus_we,
+  output reg         bus_re
+);
+
+  // ---------------------------------------------------------
+  // Register-Offsets
+  // ---------------------------------------------------------
+  localparam CTRL_OFFSET   = 8'h00;
+  localparam SRC_OFFSET    = 8'h04;
+  localparam DST_OFFSET    = 8'h08;
+  localparam LEN_OFFSET    = 8'h0C;
+  localparam STATUS_OFFSET = 8'h10;
+
+  // ---------------------------------------------------------
+  // Elementgrößen und Takt-Quellen
+  // ---------------------------------------------------------
+  localparam SIZE_8        = 2'd0;
+  localparam SIZE_16       = 2'd1;
+
+  localparam PACE_UART     = 2'd1;
+  localparam PACE_SPI      = 2'd2;
+
+  // ---------------------------------------------------------
+  // Zustände
+  // ---------------------------------------------------------
+  localparam S_IDLE        = 3'd0;
+  localparam S_REQ         = 3'd1;
+  localparam S_RD_WAIT     = 3'd2;
+  localparam S_RD_DATA     = 3'd3;
+  localparam S_WRITE       = 3'd4;
+  localparam S_WR_WAIT     = 3'd5;
+
+  // ---------------------------------------------------------
+  // Register
+  // ---------------------------------------------------------
+  reg [31:0] src;
+  reg [31:0] dst;
+  reg [31:0] len;
+  reg [31:0] src_word;      // Zwischengespeichertes Quellwort
+  reg [29:0] src_word_addr; // Wortadresse von src_word
+  reg [ 2:0] state;
+  reg [ 1:0] size;
+  reg [ 1:0] pace;
+  reg        src_word_valid;
+  reg        src_inc;
+  reg        dst_inc;
+  reg        busy;
+  reg        done;
+
+  // ---------------------------------------------------------
+  // Abgeleitete Signale
+  // ---------------------------------------------------------
+  reg  [31:0] element;
+  wire [31:0] step;
+  wire        pace_full;
+  wire        word_hit;
+
+  assign step      = (size == SIZE_8)  ? 32'd1 :
+                     (size == SIZE_16) ? 32'd2 : 32'd4;
+
+  assign pace_full = ((pace == PACE_UART) && uart_tx_full) ||
+                     ((pace == PACE_SPI)  && spi_tx_full);
+
+  assign word_hit  = src_word_valid && (src_word_addr == src[31:2]);
+
+  // ---------------------------------------------------------
+  // Element aus dem Quellwort auswählen (Little Endian)
+  // ---------------------------------------------------------
+  always @( * )
+  begin
+    case (size)
+      SIZE_8:
+        case (src[1:0])
+          2'b00:   element = {24'd0, src_word[ 7: 0]};
+          2'b01:   element = {24'd0, src_word[15: 8]};
+          2'b10:   element = {24'd0, src_word[23:16]};
+          default: element = {24'd0, src_word[31:24]};
+        endcase
+
+      SIZE_16:
+        element = src[1] ? {16'd0, src_word[31:16]} : {16'd0, src_word[15:0]};
+
+      default:
+        element = src_word;
+    endcase
+  end
+
+  // ---------------------------------------------------------
+  // Lesezugriffe auf die Register
+  // ---------------------------------------------------------
+  assign read_data = (address == CTRL_OFFSET)   ? {25'd0, pace, dst_inc, src_inc, size, busy} :
+                     (address == SRC_OFFSET)    ? src :
+                     (address == DST_OFFSET)    ? dst :
+                     (address == LEN_OFFSET)    ? len :
+                     (address == STATUS_OFFSET) ? {30'd0, done, busy} :
+                     32'd0;
+
+  // ---------------------------------------------------------
+  // Registerzugriffe und Transfer-Zustandsmaschine
+  // Die CPU kann nur schreiben, solange sie nicht in FETCH
+  // gehalten wird, also nie während eines Elementtransfers.
+  // ---------------------------------------------------------
+  always @(posedge clk or negedge rst_n)
+  begin
+    if (!rst_n)
+    begin
+      state          <= S_IDLE;
+      src            <= 32'd0;
+      dst            <= 32'd0;
+      len            <= 32'd0;
+      src_word       <= 32'd0;
+      src_word_addr  <= 30'd0;
+      src_word_valid <= 1'b0;
+      size           <= SIZE_8;
+      pace           <= 2'd0;
+      src_inc        <= 1'b0;
+      dst_inc        <= 1'b0;
+      busy           <= 1'b0;
+      done           <= 1'b0;
+      bus_hold       <= 1'b0;
+      bus_address    <= 32'd0;
+      bus_write_data <= 32'd0;
+      bus_we         <= 1'b0;
+      bus_re         <= 1'b0;
+    end
+    else
+    begin
+      bus_we <= 1'b0;
+      bus_re <= 1'b0;
+
+      if (we)
+      begin
+
+        case (address)
+
+          CTRL_OFFSET:
+          begin
+            size           <= write_data[2:1];
+            src_inc        <= write_data[3];
+            dst_inc        <= write_data[4];
+            pace           <= write_data[6:5];
+            busy           <= write_data[0];
+            done           <= 1'b0;
+            src_word_valid <= 1'b0;
+          end
+
+          SRC_OFFSET: src <= write_data;
+          DST_OFFSET: dst <= write_data;
+          LEN_OFFSET: len <= write_data;
+
+          default: ;
+
+        endcase
+      end
+      else
+      begin
+
+        case (state)
+
+          // Nächstes Element vorbereiten oder Transfer beenden
+          S_IDLE:
+          begin
+            bus_hold <= 1'b0;
+
+            if (busy)
+            begin
+              if (len == 32'd0)
+              begin
+                busy <= 1'b0;
+                done <= 1'b1;
+              end
+              else
+                state <= S_REQ;
+            end
+          end
+
+          // Bus anfordern, sobald das Ziel Platz hat
+          S_REQ:
+          begin
+            if (!busy)
+            begin
+              bus_hold <= 1'b0;
+              state    <= S_IDLE;
+            end
+            else if (pace_full)
+              bus_hold <= 1'b0;
+            else if (bus_hold && bus_grant)
+            begin
+              if (word_hit)
+                state <= S_WRITE;
+              else
+              begin
+                bus_re      <= 1'b1;
+                bus_address <= {src[31:2], 2'b00};
+                state       <= S_RD_WAIT;
+              end
+            end
+            else
+              bus_hold <= 1'b1;
+          end
+
+          // Warten auf read_data (wie WAIT in der CPU)
+          S_RD_WAIT:
+          begin
+            if (!(bus_busy || bus_re))
+              state <= S_RD_DATA;
+          end
+
+          S_RD_DATA:
+          begin
+            src_word       <= bus_read_data;
+            src_word_addr  <= src[31:2];
+            src_word_valid <= 1'b1;
+            state          <= S_WRITE;
+          end
+
+          S_WRITE:
+          begin
+            bus_we         <= 1'b1;
+            bus_address    <= dst;
+            bus_write_data <= element;
+            state          <= S_WR_WAIT;
+          end
+
+          // Schreibzugriff abschließen, Bus für eine Instruktion freigeben
+          S_WR_WAIT:
+          begin
+            if (!(bus_busy || bus_we))
+            begin
+              if (src_inc)
+                src <= src + step;
+              if (dst_inc)
+                dst <= dst + step;
+              len      <= len - 32'd1;
+              bus_hold <= 1'b0;
+              state    <= S_IDLE;
+            end
+          end
+
+          default:
+          begin
+            bus_hold <= 1'b0;
+            state    <= S_IDLE;
+          end
+
+        endcase
+      end
+    end
+  end
+
+endmodule
@@ -9,7 +9,8 @@
  * werden über das `wr_en` Signal hineingeschrieben und über das
  * `rd_en` Signal ausgelesen. Das Modul liefert die Signale `empty`
  * und `full`, um anzuzeigen, ob weitere Lese- oder Schreibvorgänge
- * möglich sind.
+ * möglich sind. Über `level` ist zusätzlich die aktuelle Anzahl
+ * belegter Einträge lesbar.
  *
  * @parameter DATA_WIDTH Breite der gespeicherten Daten in Bits.
  * @parameter DEPTH      Anzahl der Einträge im FIFO.
@@ -22,6 +23,7 @@
  * @input rd_en    Aktivierungssignal (Read-Enable) zum Lesen aus dem FIFO.
  * @output empty   Signal, das anzeigt, ob der FIFO leer ist.
  * @output full    Signal, das anzeigt, ob der FIFO voll ist.
+ * @output level   Anzahl der belegten Einträge (0..DEPTH).
  * @input din      Eingangsdaten mit Breite `DATA_WIDTH`.
  * @output dout    Ausgangsdaten mit Breite `DATA_WIDTH`.
  */
@@ -35,6 +37,7 @@ module fifo #(
     input  wire                  rd_en,
     output wire                  empty,
     output wire                  full,
+    output wire [$clog2(DEPTH):0] level,
     input  wire [DATA_WIDTH-1:0] din,
     output wire [DATA_WIDTH-1:0] dout
   );
@@ -73,6 +76,12 @@ module fifo #(
                    
   assign next_wr = (wr_ptr   + 1);
 
+  // ---------------------------------------------------------
+  // Füllstand: Differenz der Zeiger inklusive MSB, damit ein
+  // voller FIFO DEPTH und nicht 0 liefert
+  // ---------------------------------------------------------
+  assign level   = (wr_ptr - rd_ptr);
+
   // ---------------------------------------------------------
   // Lese-/Schreiblogik
   // ---------------------------------------------------------
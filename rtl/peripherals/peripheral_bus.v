@@ -21,6 +21,7 @@
  * @localparam SPI_BASE    Basis-Adressenbereich für das SPI-Modul
  * @localparam GPIO_BASE   Basis-Adressenbereich für das GPIO-Modul
  * @localparam WS_BASE     Basis-Adressenbereich für das WS2812B-Modul
+ * @localparam DMA_BASE    Basis-Adressenbereich für den DMA-Controller
  *
  * @input clk         Systemtakt
  * @input rst_n       Asynchrones, aktives-LOW Reset-Signal
@@ -42,6 +43,15 @@
  * @output [7:0]      gpio_out Ausgangssignale des GPIO-Moduls
  * @output [7:0]      gpio_dir Richtungsregister des GPIO-Moduls
  * @input  [7:0]      gpio_in  Eingangsleitungen des GPIO-Moduls
+ *
+ * @output dma_hold          Busanforderung des DMA (hält die CPU in FETCH)
+ * @input  dma_grant         Bus ist dem DMA zugeteilt
+ * @input  mem_busy          Speicherzugriff noch in Arbeit
+ * @output [31:0]     dma_address    Adresse des DMA-Zugriffs
+ * @output [31:0]     dma_write_data Daten des DMA-Schreibzugriffs
+ * @input  [31:0]     dma_read_data  Gelesene Daten für den DMA
+ * @output dma_we            Write-Enable des DMA
+ * @output dma_re            Read-Enable des DMA
  */
 
 module peripheral_bus (
@@ -63,7 +73,15 @@ module peripheral_bus (
   output wire        spi_cs,
   output wire [ 7:0] gpio_out,
   output wire [ 7:0] gpio_dir,
-  input  wire [ 7:0] gpio_in
+  input  wire [ 7:0] gpio_in,
+  output wire        dma_hold,
+  input  wire        dma_grant,
+  input  wire        mem_busy,
+  output wire [31:0] dma_address,
+  output wire [31:0] dma_write_data,
+  input  wire [31:0] dma_read_data,
+  output wire        dma_we,
+  output wire        dma_re
 );
 
   // Basis-Adressen für die einzelnen Peripherie-Komponenten
@@ -76,6 +94,7 @@ module peripheral_bus (
   localparam SPI_BASE    = 6'h07;
   localparam GPIO_BASE   = 6'h08;
   localparam WS_BASE     = 6'h09;
+  localparam DMA_BASE    = 6'h0A;
 
   // Aus der 14-Bit-Adresse wird hier der 8-Bit-Funktionsanteil extrahiert
   // (lower 8 Bits), um innerhalb des Peripheriemoduls weiter zu dekodieren.
@@ -124,6 +143,7 @@ module peripheral_bus (
 `ifdef INCLUDE_UART
 
   wire [31:0] uart_data;
+  wire        uart_tx_full;
 
   wire uart_sel;
   wire uart_we;
@@ -145,12 +165,14 @@ module peripheral_bus (
     .we         (uart_we),
     .re         (uart_re),
     .uart_tx    (uart_tx),
-    .uart_rx    (uart_rx)
+    .uart_rx    (uart_rx),
+    .tx_full    (uart_tx_full)
   );
 
 `else
   wire  [31:0]  uart_data = 32'h0;
   wire          uart_sel  = 1'b0;
+  wire          uart_tx_full = 1'b0;
   assign        uart_tx   = 1'b0;
 `endif
 
@@ -287,6 +309,7 @@ module peripheral_bus (
 `ifdef INCLUDE_SPI
 
   wire [31:0] spi_data;
+  wire        spi_tx_full;
 
   wire spi_sel;
   wire spi_we;
@@ -310,12 +333,14 @@ module peripheral_bus (
     .spi_clk    (spi_clk),
     .spi_mosi   (spi_mosi),
     .spi_miso   (spi_miso),
-    .spi_cs     (spi_cs)
+    .spi_cs     (spi_cs),
+    .tx_full    (spi_tx_full)
   );
 
 `else
   wire [31:0] spi_data = 32'h0;
   wire        spi_sel  = 1'b0;
+  wire        spi_tx_full = 1'b0;
   assign      spi_mosi = 1'b0;
   assign      spi_clk  = 1'b0;
   assign      spi_cs   = 1'b1;
@@ -390,6 +415,52 @@ module peripheral_bus (
   assign      ws_out  = 1'b0;
 `endif
 
+  // ---------------------------------------------------------
+  // DMA-Controller (optional über DEFINE eingebunden)
+  // Der Master-Port wird in memory.v mit dem Bus der CPU gemultiplext
+  // ---------------------------------------------------------
+`ifdef INCLUDE_DMA
+
+  wire [31:0] dma_data;
+
+  wire dma_sel;
+  wire dma_reg_we;
+  wire dma_reg_re;
+
+  assign dma_sel     = (address[12:8] == DMA_BASE);
+  assign dma_reg_we  = we & dma_sel;
+  assign dma_reg_re  = re & dma_sel;
+
+  dma dma_inst (
+    .clk            (clk),
+    .rst_n          (rst_n),
+    .address        (func_addr),
+    .write_data     (write_data),
+    .read_data      (dma_data),
+    .we             (dma_reg_we),
+    .re             (dma_reg_re),
+    .uart_tx_full   (uart_tx_full),
+    .spi_tx_full    (spi_tx_full),
+    .bus_hold       (dma_hold),
+    .bus_grant      (dma_grant),
+    .bus_busy       (mem_busy),
+    .bus_address    (dma_address),
+    .bus_write_data (dma_write_data),
+    .bus_read_data  (dma_read_data),
+    .bus_we         (dma_we),
+    .bus_re         (dma_re)
+  );
+
+`else
+  wire [31:0] dma_data       = 32'h0;
+  wire        dma_sel        = 1'b0;
+  assign      dma_hold       = 1'b0;
+  assign      dma_address    = 32'h0;
+  assign      dma_write_data = 32'h0;
+  assign      dma_we         = 1'b0;
+  assign      dma_re         = 1'b0;
+`endif
+
   // ---------------------------------------------------------
   // Lesezugriffe: Hier wird je nach ausgewähltem Modul das passende
   // 'read_data' ausgegeben. Falls kein passendes Modul selektiert
@@ -430,6 +501,9 @@ module peripheral_bus (
 `ifdef INCLUDE_WS
       else if (ws_sel)    read_data <= ws_data;
 `endif
+`ifdef INCLUDE_DMA
+      else if (dma_sel)   read_data <= dma_data;
+`endif
 
       else
         read_data <= 32'h0;
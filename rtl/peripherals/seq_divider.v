@@ -2,33 +2,56 @@
 `timescale 1ns / 1ns
 
 /**
- * @brief Sequentieller Divider (Divisionseinheit).
+ * @brief Sequentieller Radix-4-Divider (Divisionseinheit).
  *
- * Dieses Modul führt eine sequentielle Division zweier 32-Bit-Werte durch.
- * Dabei wird fortlaufend ein Teil des Dividenden mit dem Divisor verglichen
- * und angepasst. Das Modul ist über ein Register-Interface ansprechbar:
+ * Dieses Modul dividiert zwei 32-Bit-Werte und liefert Quotient und Rest
+ * aus einer einzigen Berechnung. Pro Takt werden zwei Quotientenbits
+ * bestimmt (Radix 4, restaurierend). Führende Nullbits des Dividenden
+ * werden übersprungen: Es werden nur so viele Schritte ausgeführt, wie der
+ * Quotient signifikante Bits haben kann (nlz(Divisor) - nlz(Dividend) + 1).
+ * Ist der Dividend kleiner als der Divisor oder der Divisor 0, endet die
+ * Division ohne Rechenschritt.
+ *
+ * Latenz in Takten (busy = 1): 2 + ceil(Quotientenbits / 2), also 2 bis 18.
+ * Die Latenz hängt nur von den Operanden ab und lässt sich daher vor dem
+ * Start berechnen (`div_predict_latency` in der HAL). `LAT_OFFSET` enthält
+ * die gemessene Latenz der letzten Division für Profiling-Zwecke.
+ *
+ * Register-Interface:
  * - `INFO_OFFSET`: Enthält das `busy`-Bit (Division noch aktiv).
  * - `END_OFFSET` : Speicherort für den Dividenden (Endwert).
- * - `SOR_OFFSET` : Speicherort für den Divisor (Startet die Division).
+ * - `SOR_OFFSET` : Divisor, startet eine vorzeichenlose Division.
  * - `QUO_OFFSET` : Liefert das Ergebnis (Quotient).
  * - `REM_OFFSET` : Liefert den Restwert (Remainder).
+ * - `SSOR_OFFSET`: Divisor, startet eine vorzeichenbehaftete Division.
+ * - `LAT_OFFSET` : Latenz der letzten Division in Takten.
+ *
+ * Vorzeichenbehaftet gilt die RISC-V-Semantik: Der Quotient wird Richtung 0
+ * gerundet, der Rest hat das Vorzeichen des Dividenden. Bei Divisor 0 ist
+ * der Quotient 0xFFFFFFFF und der Rest der Dividend, -2^31 / -1 ergibt
+ * -2^31 mit Rest 0.
+ *
+ * Die Operanden werden beim Start übernommen, `END_OFFSET` darf daher schon
+ * während einer laufenden Division für die nächste beschrieben werden.
  *
  * @localparam INFO_OFFSET Offset für das Statusregister (busy).
  * @localparam END_OFFSET  Offset für den Dividenden.
- * @localparam SOR_OFFSET  Offset für den Divisor (startet Division).
+ * @localparam SOR_OFFSET  Offset für den Divisor (startet vorzeichenlose Division).
  * @localparam QUO_OFFSET  Offset für den Quotienten.
  * @localparam REM_OFFSET  Offset für den Rest.
+ * @localparam SSOR_OFFSET Offset für den Divisor (startet vorzeichenbehaftete Division).
+ * @localparam LAT_OFFSET  Offset für die Latenz der letzten Division.
  *
  * @input  clk               Systemtakt.
  * @input  rst_n             Aktiv-low Reset.
  * @input  [7:0] address     Adresse für den Registerzugriff.
  * @input  [31:0] write_data Daten, die z. B. Dividenden/Divisor setzen.
-*  @output [31:0] read_data  Ausgabedaten basierend auf address.
+ * @output [31:0] read_data  Ausgabedaten basierend auf address.
  * @input  we                Schreibaktivierungssignal (Write-Enable).
  * @input  re                Leseaktivierungssignal (Read-Enable).
  */
 
-module seq_divider ( 
+module seq_divider (
   input  wire        clk,
   input  wire        rst_n,
   input  wire [ 7:0] address,
@@ -42,57 +65,199 @@ module seq_divider (
   // ---------------------------------------------------------
   // Lokale Adress-Offsets für das Register-Interface
   // ---------------------------------------------------------
-  localparam INFO_OFFSET = 8'h00; 
-  localparam END_OFFSET  = 8'h04; 
-  localparam SOR_OFFSET  = 8'h08; 
-  localparam QUO_OFFSET  = 8'h0C; 
+  localparam INFO_OFFSET = 8'h00;
+  localparam END_OFFSET  = 8'h04;
+  localparam SOR_OFFSET  = 8'h08;
+  localparam QUO_OFFSET  = 8'h0C;
   localparam REM_OFFSET  = 8'h10;
+  localparam SSOR_OFFSET = 8'h14;
+  localparam LAT_OFFSET  = 8'h18;
+
+  // ---------------------------------------------------------
+  // Zustände
+  // ---------------------------------------------------------
+  localparam S_IDLE      = 2'd0;
+  localparam S_SETUP     = 2'd1;
+  localparam S_RUN       = 2'd2;
+  localparam S_DONE      = 2'd3;
 
   // ---------------------------------------------------------
   // Register für Dividenden, Divisor, Quotient und Rest
-  // dvdend_tmp dient als Arbeitsregister (64 Bit),
-  // um den Dividenden hochzuschieben und den Rest auszuarbeiten.
+  // work_r ist der Teilrest, work_q schiebt die restlichen
+  // Dividendenbits hinaus und die Quotientenbits hinein.
   // ---------------------------------------------------------
-  reg [31:0] dividend; // Gespeicherter Dividendenwert
-  reg [31:0] divisor;  // Gespeicherter Divisor
-  reg [63:0] dvdend_tmp; // Temporäre 64-Bit-Repräsentation des Dividenden
+  reg [31:0] dividend;  // Gespeicherter Dividendenwert
+  reg [31:0] divisor;   // Gespeicherter Divisor
   reg [31:0] quotient;  // Quotient
   reg [31:0] remainder; // Rest
-  reg [ 5:0] bit_index; // Zähler für 32-Bit schrittweise Division
-  reg        busy;  // Signalisiert laufende Division
+  reg [31:0] op_end;    // Dividend der laufenden Division
+  reg [31:0] abs_sor;   // Betrag des Divisors der laufenden Division
+  reg [31:0] work_r;    // Teilrest
+  reg [31:0] work_q;    // Dividenden-/Quotienten-Schieberegister
+  reg [ 4:0] steps;     // Verbleibende Radix-4-Schritte
+  reg [ 4:0] cycles;    // Takte der laufenden Division
+  reg [ 4:0] latency;   // Takte der letzten Division
+  reg [ 1:0] state;
+  reg        sign_mode; // Laufende Division ist vorzeichenbehaftet
+  reg        neg_quo;   // Quotient am Ende negieren
+  reg        neg_rem;   // Rest am Ende negieren
+
+  wire       busy;
+
+  assign busy = (state != S_IDLE);
+
+  // ---------------------------------------------------------
+  // Führende Nullen eines 32-Bit-Werts (32 für 0)
+  // ---------------------------------------------------------
+  function [5:0] nlz;
+    input [31:0] value;
+    integer k;
+    begin
+      nlz = 6'd32;
+      for (k = 0; k < 32; k = k + 1)
+        if (value[k])
+          nlz = 31 - k;
+    end
+  endfunction
+
+  // ---------------------------------------------------------
+  // SETUP: Beträge bilden und Anzahl der Schritte bestimmen
+  // ---------------------------------------------------------
+  wire [31:0] abs_end;
+  wire [ 5:0] q_bits;
+  wire [ 4:0] setup_steps;
+  wire [ 4:0] setup_shift;
+  wire [63:0] setup_window;
+
+  assign abs_end      = (sign_mode && op_end[31]) ? -op_end : op_end;
+  assign q_bits       = nlz(abs_sor) - nlz(abs_end) + 6'd1;
+  assign setup_steps  = q_bits[5:1] + {4'd0, q_bits[0]};
+  assign setup_shift  = 5'd0 - {setup_steps[3:0], 1'b0};
+  assign setup_window = {32'd0, abs_end} << setup_shift;
+
+  // ---------------------------------------------------------
+  // RUN: ein Radix-4-Schritt, Vergleich mit 3d, 2d und d
+  // ---------------------------------------------------------
+  wire [33:0] r4;
+  wire [33:0] sor_x1;
+  wire [33:0] sor_x2;
+  wire [33:0] sor_x3;
+  wire [33:0] r4_sub;
+  wire [ 1:0] q_digit;
+
+  assign r4      = {work_r, work_q[31:30]};
+  assign sor_x1  = {2'b00, abs_sor};
+  assign sor_x2  = {1'b0, abs_sor, 1'b0};
+  assign sor_x3  = sor_x1 + sor_x2;
+
+  assign q_digit = (r4 >= sor_x3) ? 2'd3 :
+                   (r4 >= sor_x2) ? 2'd2 :
+                   (r4 >= sor_x1) ? 2'd1 : 2'd0;
+
+  assign r4_sub  = (q_digit == 2'd3) ? r4 - sor_x3 :
+                   (q_digit == 2'd2) ? r4 - sor_x2 :
+                   (q_digit == 2'd1) ? r4 - sor_x1 : r4;
 
   // ---------------------------------------------------------
   // Lesezugriffe: abhängig vom Offset wird das passende
   // Register oder das busy-Bit zurückgegeben.
   // ---------------------------------------------------------
-  assign read_data = (address == INFO_OFFSET) ? {31'd0, busy} : 
-                     (address == END_OFFSET)  ?  dividend     : 
-                     (address == SOR_OFFSET)  ?  divisor      : 
-                     (address == QUO_OFFSET)  ?  quotient     : 
-                     (address == REM_OFFSET)  ?  remainder    : 
+  assign read_data = (address == INFO_OFFSET) ? {31'd0, busy}     :
+                     (address == END_OFFSET)  ?  dividend         :
+                     (address == SOR_OFFSET)  ?  divisor          :
+                     (address == QUO_OFFSET)  ?  quotient         :
+                     (address == REM_OFFSET)  ?  remainder        :
+                     (address == SSOR_OFFSET) ?  divisor          :
+                     (address == LAT_OFFSET)  ? {27'd0, latency}  :
                      32'd0;
 
 
   // ---------------------------------------------------------
   // Sequentieller Ablauf:
-  // - Schreiben von dividend und divisor startet Berechnung.
-  // - Der Divisor wird sukzessive vom oberen Teil des Dividenden
-  //   subtrahiert (wenn möglich), das Ergebnis fließt in quotient.
+  // - Schreiben des Divisors übernimmt die Operanden und startet.
+  // - SETUP entscheidet über Sonderfälle und richtet den
+  //   Dividenden auf die signifikanten Quotientenbits aus.
+  // - RUN bestimmt pro Takt zwei Quotientenbits.
+  // - DONE korrigiert die Vorzeichen und legt das Ergebnis ab.
   // ---------------------------------------------------------
   always @(posedge clk or negedge rst_n)
   begin
     if (!rst_n)
     begin
-      dividend   <= 32'd0;
-      divisor    <= 32'd0;
-      quotient   <= 32'd0;
-      remainder  <= 32'd0;
-      dvdend_tmp <= 64'd0;
-      bit_index  <= 6'd0;
-      busy       <= 1'b0;
+      dividend  <= 32'd0;
+      divisor   <= 32'd0;
+      quotient  <= 32'd0;
+      remainder <= 32'd0;
+      op_end    <= 32'd0;
+      abs_sor   <= 32'd0;
+      work_r    <= 32'd0;
+      work_q    <= 32'd0;
+      steps     <= 5'd0;
+      cycles    <= 5'd0;
+      latency   <= 5'd0;
+      state     <= S_IDLE;
+      sign_mode <= 1'b0;
+      neg_quo   <= 1'b0;
+      neg_rem   <= 1'b0;
     end
     else
     begin
+      if (busy)
+        cycles <= cycles + 5'd1;
+
+      case (state)
+
+        S_SETUP:
+        begin
+          neg_quo <= sign_mode && (op_end[31] ^ divisor[31]);
+          neg_rem <= sign_mode && op_end[31];
+          state   <= S_DONE;
+
+          if (abs_sor == 32'd0)
+          begin
+            // Division durch 0: Quotient alle Bits gesetzt, Rest = Dividend
+            neg_quo <= 1'b0;
+            neg_rem <= 1'b0;
+            work_q  <= 32'hFFFFFFFF;
+            work_r  <= op_end;
+          end
+          else if (abs_end < abs_sor)
+          begin
+            // Quotient 0, kein Rechenschritt nötig
+            work_q  <= 32'd0;
+            work_r  <= abs_end;
+          end
+          else
+          begin
+            work_r  <= setup_window[63:32];
+            work_q  <= setup_window[31: 0];
+            steps   <= setup_steps;
+            state   <= S_RUN;
+          end
+        end
+
+        S_RUN:
+        begin
+          work_r <= r4_sub[31:0];
+          work_q <= {work_q[29:0], q_digit};
+          steps  <= steps - 5'd1;
+
+          if (steps == 5'd1)
+            state <= S_DONE;
+        end
+
+        S_DONE:
+        begin
+          quotient  <= neg_quo ? -work_q : work_q;
+          remainder <= neg_rem ? -work_r : work_r;
+          latency   <= cycles;
+          state     <= S_IDLE;
+        end
+
+        default: ;
+
+      endcase
+
       // Verarbeiten von Write-Zugriffen
       if (we)
       begin
@@ -100,52 +265,30 @@ module seq_divider (
 
           END_OFFSET:
           begin
-            // Setzt den Dividenden und initialisiert das Arbeitsregister
-            dividend   <= write_data;
-            dvdend_tmp <= {32'd0, write_data}; 
-            quotient   <= 32'd0;
-            remainder  <= 32'd0;
+            // Setzt den Dividenden
+            dividend  <= write_data;
+            if (!busy)
+            begin
+              quotient  <= 32'd0;
+              remainder <= 32'd0;
+            end
           end
 
-          SOR_OFFSET:
+          SOR_OFFSET,
+          SSOR_OFFSET:
           begin
-            // Setzt den Divisor und aktiviert die Division
-            divisor    <= write_data;
-            bit_index  <= 6'd31;
-            busy       <= 1'b1;
+            // Übernimmt die Operanden und startet die Division
+            divisor   <= write_data;
+            op_end    <= dividend;
+            abs_sor   <= ((address == SSOR_OFFSET) && write_data[31]) ? -write_data : write_data;
+            sign_mode <= (address == SSOR_OFFSET);
+            cycles    <= 5'd1;
+            state     <= S_SETUP;
           end
 
-        endcase
-      end
-
-
-      // Division in kleinen Schritten, solange busy=1
-      if (busy)
-      begin
-        // Jede Iteration: 
-        // 1) Schiebe das 64-Bit-Fenster nach links (dvdend_tmp << 1),
-        // 2) Schiebe quotient nach links, 
-        // 3) teste, ob Divisor subtrahierbar ist.
-        dvdend_tmp <= dvdend_tmp << 1;
-        quotient   <= quotient << 1;
-
-        // Prüfe den oberen 32-Bit-Teil gegen divisor
-        if (dvdend_tmp[63:32] >= divisor)
-        begin
-          dvdend_tmp[63:32] <= dvdend_tmp[63:32] - divisor;
-          quotient[0] = 1;
-        end
+          default: ;
 
-        // Sobald alle Bits bearbeitet sind, legen wir remainder fest.
-        if (bit_index == 0)
-        begin
-          remainder <= dvdend_tmp[63:32];
-          busy <= 1'b0;
-        end
-        else
-        begin
-          bit_index <= bit_index - 1;
-        end
+        endcase
       end
     end
   end
@@ -1,25 +1,39 @@
+`include "../defines.v"
 `default_nettype none
 `timescale 1ns / 1ns
 
 /**
- * @brief Sequentieller Multiplikator.
+ * @brief Hardware-Multiplikator (sequentiell, Radix-4-Booth oder DSP).
  *
- * Dieses Modul implementiert eine sequentielle Multiplikation zweier
- * 32-Bit-Werte. Die Multiplikation erfolgt durch aufeinanderfolgende
- * Additionen basierend auf den Bits des Multiplikators.
+ * Dieses Modul multipliziert zwei vorzeichenlose 32-Bit-Werte zu einem
+ * 64-Bit-Ergebnis. Die Implementierung wird in `defines.v` gewählt:
+ * - ohne weitere Defines: ein Multiplikatorbit pro Takt (32 Takte).
+ * - `MULT_BOOTH`: Radix-4-Booth, zwei Multiplikatorbits pro Takt
+ *   (17 Takte), für das Flächenbudget des ASIC.
+ * - `MULT_DSP`: Ein-Takt-Multiplikation über `*`, wird von Quartus auf
+ *   DSP-Blöcke abgebildet. `busy` wird nie gesetzt.
+ * - `MULT_EARLY_OUT` (nur sequentiell/Booth): Der kleinere Operand wird
+ *   als Multiplikator verwendet und die Berechnung endet, sobald keine
+ *   gesetzten Multiplikatorbits mehr übrig sind.
+ *
+ * Die Operanden werden beim Start übernommen, `MUL1_OFFSET` darf daher
+ * schon während einer laufenden Multiplikation beschrieben werden.
  *
  * Das Modul ist speicherabbildbasiert und kann über Adressen gesteuert werden:
  * - `MUL1_OFFSET`: Erster Multiplikand.
  * - `MUL2_OFFSET`: Zweiter Multiplikator (startet die Berechnung).
  * - `RESH_OFFSET`: Höhere 32 Bits des Ergebnisses.
  * - `RESL_OFFSET`: Niedrigere 32 Bits des Ergebnisses.
- * - `INFO_OFFSET`: Gibt an, ob die Berechnung noch läuft (`busy`).
+ * - `INFO_OFFSET`: Bit 0 `busy`, Bit 15:8 maximale Latenz in Takten
+ *                  (0 = Ergebnis sofort gültig), Bit 16 Early-Out aktiv.
  *
- * @localparam INFO_OFFSET Adresse für den Status (`busy`-Bit).
+ * @localparam INFO_OFFSET Adresse für den Status (`busy`, Latenz).
  * @localparam MUL1_OFFSET Adresse für den ersten Multiplikanden.
  * @localparam MUL2_OFFSET Adresse für den zweiten Multiplikator (startet Berechnung).
  * @localparam RESH_OFFSET Adresse für die höheren 32 Bit des Ergebnisses.
  * @localparam RESL_OFFSET Adresse für die niedrigeren 32 Bit des Ergebnisses.
+ * @localparam MULT_LATENCY Maximale Anzahl Takte mit `busy` = 1.
+ * @localparam MULT_EARLY   1, wenn die Berechnung vorzeitig enden kann.
  *
  * @input clk         Systemtakt.
  * @input rst_n       Aktiv-low Reset.
@@ -48,26 +62,118 @@ module seq_multiplier (
   localparam RESH_OFFSET = 8'h0C;
   localparam RESL_OFFSET = 8'h10;
 
+  // -------------------------------------------------------
+  // Gewählte Implementierung
+  // -------------------------------------------------------
+`ifdef MULT_DSP
+  localparam MULT_LATENCY = 8'd0;
+  localparam MULT_EARLY   = 1'b0;
+`else
+`ifdef MULT_BOOTH
+  localparam MULT_LATENCY = 8'd17;
+`else
+  localparam MULT_LATENCY = 8'd32;
+`endif
+`ifdef MULT_EARLY_OUT
+  localparam MULT_EARLY   = 1'b1;
+`else
+  localparam MULT_EARLY   = 1'b0;
+`endif
+`endif
+
   // -------------------------------------------------------
   // Register für Multiplikanden, Ergebnis und Steuerung
   // -------------------------------------------------------
   reg [31:0] multiplicand;
   reg [31:0] multiplier;
   reg [63:0] product;
-  reg [ 5:0] bit_index;
   reg        busy;
 
   // -------------------------------------------------------
   // Leseausgabe: Je nach Adress-Offset wird entsprechender
   // Registerinhalt oder Status zurückgegeben.
   // -------------------------------------------------------
-  assign read_data = (address == INFO_OFFSET) ? {31'd0, busy} :
+  assign read_data = (address == INFO_OFFSET) ? {15'd0, MULT_EARLY, MULT_LATENCY, 7'd0, busy} :
                      (address == MUL1_OFFSET) ? multiplicand  :
                      (address == MUL2_OFFSET) ? multiplier    :
                      (address == RESH_OFFSET) ? product[63:32]:
                      (address == RESL_OFFSET) ? product[31: 0]:
                      32'd0;
 
+`ifdef MULT_DSP
+
+  // -------------------------------------------------------
+  // Ein-Takt-Multiplikation (DSP-Blöcke)
+  // -------------------------------------------------------
+  always @(posedge clk or negedge rst_n)
+  begin
+    if (!rst_n) begin
+      multiplicand <= 32'd0;
+      multiplier   <= 32'd0;
+      product      <= 64'd0;
+      busy         <= 1'b0;
+    end
+    else
+    begin
+      if (we)
+      begin
+        case (address)
+          MUL1_OFFSET: begin
+            multiplicand <= write_data;
+          end
+          MUL2_OFFSET: begin
+            multiplier <= write_data;
+            product    <= multiplicand * write_data;
+          end
+          default: ;
+        endcase
+      end
+    end
+  end
+
+`else
+
+  // -------------------------------------------------------
+  // Arbeitsregister: mcand wird pro Schritt nach links,
+  // mplier nach rechts geschoben. Alle Summen modulo 2^64,
+  // negative Booth-Summanden heben sich bis zum Ende auf.
+  // -------------------------------------------------------
+  reg  [63:0] mcand;
+  reg  [33:0] mplier;
+  reg         booth_prev; // Zuletzt hinausgeschobenes Multiplikatorbit
+  reg  [ 5:0] steps;      // Verbleibende Schritte
+  reg  [63:0] addend;
+  wire [33:0] mplier_next;
+  wire        mplier_done;
+
+`ifdef MULT_BOOTH
+  // Radix 4: Ziffer aus {mplier[1:0], booth_prev} in {-2, -1, 0, 1, 2}
+  always @( * )
+  begin
+    case ({mplier[1:0], booth_prev})
+      3'b001,
+      3'b010:  addend = mcand;
+      3'b011:  addend = mcand << 1;
+      3'b100:  addend = -(mcand << 1);
+      3'b101,
+      3'b110:  addend = -mcand;
+      default: addend = 64'd0;
+    endcase
+  end
+
+  assign mplier_next = mplier >> 2;
+  assign mplier_done = (mplier_next == 34'd0) && !mplier[1];
+`else
+  // Radix 2: ein Bit pro Takt
+  always @( * )
+  begin
+    addend = mplier[0] ? mcand : 64'd0;
+  end
+
+  assign mplier_next = mplier >> 1;
+  assign mplier_done = (mplier_next == 34'd0);
+`endif
+
   // -------------------------------------------------------
   // Sequentielle Abarbeitung der Multiplikation
   // -------------------------------------------------------
@@ -78,11 +184,32 @@ module seq_multiplier (
       multiplicand <= 32'd0;
       multiplier   <= 32'd0;
       product      <= 64'd0;
-      bit_index    <= 6'd0;
+      mcand        <= 64'd0;
+      mplier       <= 34'd0;
+      booth_prev   <= 1'b0;
+      steps        <= 6'd0;
       busy         <= 1'b0;
     end
     else
     begin
+      // Wenn busy = 1, läuft die sequentielle Multiplikation
+      if (busy)
+      begin
+        product    <= product + addend;
+`ifdef MULT_BOOTH
+        mcand      <= mcand << 2;
+`else
+        mcand      <= mcand << 1;
+`endif
+        mplier     <= mplier_next;
+        booth_prev <= mplier[1];
+        steps      <= steps - 6'd1;
+
+        // Letzter Schritt oder keine gesetzten Multiplikatorbits mehr
+        if (steps == 6'd1 || (MULT_EARLY && mplier_done))
+          busy <= 1'b0;
+      end
+
       // Behandlung von Bus-Schreibzugriffen
       if (we)
       begin
@@ -95,32 +222,28 @@ module seq_multiplier (
             // Schreiben des zweiten Multiplikators -> Start der Multiplikation
             multiplier <= write_data;
             product    <= 64'd0;
-            bit_index  <= 6'd31;
+            booth_prev <= 1'b0;
+            steps      <= MULT_LATENCY[5:0];
             busy       <= 1'b1;
+
+            // Mit Early-Out bestimmt der kleinere Operand die Laufzeit
+            if (MULT_EARLY && (write_data > multiplicand))
+            begin
+              mcand  <= {32'd0, write_data};
+              mplier <= {2'b00, multiplicand};
+            end
+            else
+            begin
+              mcand  <= {32'd0, multiplicand};
+              mplier <= {2'b00, write_data};
+            end
           end
+          default: ;
         endcase
       end
-
-      // Wenn busy = 1, läuft die sequentielle Multiplikation
-      if (busy)
-      begin
-        if (multiplier[bit_index])
-        begin
-          product <= product + ((64'd1 << bit_index) * multiplicand);
-        end
-
-        // Bitzähler reduzieren
-        if (bit_index == 0)
-        begin
-          // Sobald alle Bits durch sind, ist die Multiplikation abgeschlossen
-          busy <= 1'b0;
-        end
-        else
-        begin
-          bit_index <= bit_index - 1;
-        end
-      end
     end
   end
 
+`endif
+
 endmodule
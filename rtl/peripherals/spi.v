@@ -8,15 +8,24 @@
  * mit jeweils einem TX- und RX-FIFO zur gepufferten Übertragung von
  * Datenpaketen. Die Baudrate wird über ein konfigurierbares Clock-Divider-
  * Register gesteuert. Zusätzlich kann zwischen automatischer und manueller
- * Steuerung des CS-Signals gewählt werden.
+ * Steuerung des CS-Signals gewählt werden. Die Rahmenbreite (8, 16 oder
+ * 32 Bit) wird im Steuerregister gewählt und mit jedem TX-Eintrag im FIFO
+ * abgelegt, sodass ein Wechsel bereits eingereihte Rahmen nicht verändert.
+ * Gesendet und empfangen wird jeweils MSB zuerst, empfangene Rahmen liegen
+ * rechtsbündig im RX-FIFO.
  *
  * Register-Offsets innerhalb des Moduls:
- * - `CTRL_OFFSET`   : Steuerregister (Aktivierung, CS-Gen, etc.)
+ * - `CTRL_OFFSET`   : Steuerregister (Bit 0 Aktivierung, Bit 1 CS-Gen,
+ *                     Bit 3:2 Rahmenbreite 0 = 8, 1 = 16, 2 = 32 Bit)
  * - `CLK_OFFSET`    : Clock-Divider-Register (zur SPI-Takterzeugung)
  * - `STATUS_OFFSET` : Statusbits (z. B. Busy, FIFO-Zustände)
- * - `TX_OFFSET`     : TX-FIFO-Schreibregister
+ * - `TX_OFFSET`     : TX-FIFO-Schreibregister (bei 8 Bit: Bit 8 = Lesen)
  * - `RX_OFFSET`     : RX-FIFO-Leseregister
  * - `CS_OFFSET`     : Manuelle Chip-Select-Steuerung
+ * - `TX_LEVEL_OFFSET`: Anzahl belegter Einträge im TX-FIFO
+ * - `RX_LEVEL_OFFSET`: Anzahl belegter Einträge im RX-FIFO
+ * - `TX_READ_OFFSET`: TX-FIFO-Schreibregister, empfangener Rahmen wird
+ *                     immer in den RX-FIFO geschrieben
  *
  * @parameter FIFO_TX_DEPTH = 8 Anzahl der Einträge im FIFO für TX
  * @parameter FIFO_RX_DEPTH = 8 Anzahl der Einträge im FIFO für RX
@@ -27,6 +36,14 @@
  * @localparam TX_OFFSET     Offset zum Schreiben in den TX-FIFO
  * @localparam RX_OFFSET     Offset zum Lesen aus dem RX-FIFO
  * @localparam CS_OFFSET     Offset für manuelle Chip-Select-Steuerung
+ * @localparam TX_LEVEL_OFFSET Offset für den Füllstand des TX-FIFOs
+ * @localparam RX_LEVEL_OFFSET Offset für den Füllstand des RX-FIFOs
+ * @localparam TX_READ_OFFSET  Offset zum Schreiben in den TX-FIFO mit Lese-Flag
+ * @localparam FRAME_8       Rahmenbreite 8 Bit
+ * @localparam FRAME_16      Rahmenbreite 16 Bit
+ * @localparam FRAME_32      Rahmenbreite 32 Bit
+ * @localparam TX_LEVEL_WIDTH  Breite des TX-Füllstands
+ * @localparam RX_LEVEL_WIDTH  Breite des RX-Füllstands
  *
  * @localparam STATE_IDLE      Leerlaufzustand
  * @localparam STATE_LOAD      Daten werden aus dem TX-FIFO übernommen
@@ -45,6 +62,7 @@
  * @output reg               spi_mosi  SPI-Daten-Ausgang (Master Out, Slave In)
  * @input  wire              spi_miso  SPI-Daten-Eingang  (Master In, Slave Out)
  * @output wire              spi_cs    SPI-Chip-Select (automatisch oder manuell)
+ * @output wire              tx_full   TX-FIFO voll (Taktung des DMA)
  */
 
 module spi #(
@@ -61,7 +79,8 @@ module spi #(
   output reg         spi_clk,
   output reg         spi_mosi,
   input  wire        spi_miso,
-  output wire        spi_cs
+  output wire        spi_cs,
+  output wire        tx_full
 );
 
   // ---------------------------------------------------------
@@ -73,6 +92,22 @@ module spi #(
   localparam TX_OFFSET       = 8'h0C;
   localparam RX_OFFSET       = 8'h10;
   localparam CS_OFFSET       = 8'h14;
+  localparam TX_LEVEL_OFFSET = 8'h18;
+  localparam RX_LEVEL_OFFSET = 8'h1C;
+  localparam TX_READ_OFFSET  = 8'h20;
+
+  // ---------------------------------------------------------
+  // Kodierung der Rahmenbreite (CTRL Bit 3:2)
+  // ---------------------------------------------------------
+  localparam FRAME_8         = 2'd0;
+  localparam FRAME_16        = 2'd1;
+  localparam FRAME_32        = 2'd2;
+
+  // ---------------------------------------------------------
+  // Breite der Füllstände (0..DEPTH)
+  // ---------------------------------------------------------
+  localparam TX_LEVEL_WIDTH  = $clog2(FIFO_TX_DEPTH) + 1;
+  localparam RX_LEVEL_WIDTH  = $clog2(FIFO_RX_DEPTH) + 1;
 
 
   // ---------------------------------------------------------
@@ -89,15 +124,18 @@ module spi #(
   reg [15:0] spi_clk_div;
   reg [15:0] new_spi_clk_div;
   reg [16:0] clk_counter;
-  reg [ 7:0] tx_shift;
-  reg [ 7:0] rx_shift;
-  reg [ 7:0] rx_fifo_din;
+  reg [31:0] tx_shift;
+  reg [31:0] rx_shift;
+  reg [31:0] rx_fifo_din;
+  reg [31:0] tx_aligned;
+  reg [ 4:0] tx_last_bit;
+  reg [ 4:0] last_bit;
   reg [ 1:0] state;
-  reg [ 3:0] bit_cnt;
+  reg [ 4:0] bit_cnt;
+  reg [ 1:0] frame_sel;
   reg [ 1:0] spi_ctrl;
   reg tx_fifo_rd_en;
   reg rx_fifo_wr_en;
-  reg rx_fifo_rd_en;
   reg read_flag;
   reg spi_clk_en;
   reg active;
@@ -109,14 +147,19 @@ module spi #(
   // ---------------------------------------------------------
   // FIFOs für TX und RX
   // ---------------------------------------------------------
-  wire [8:0] tx_fifo_din;
-  wire [8:0] tx_fifo_dout;
-  wire [7:0] rx_fifo_dout;
+  // TX-Eintrag: {Rahmenbreite[1:0], Lese-Flag, Daten[31:0]}
+  wire [34:0] tx_fifo_din;
+  wire [34:0] tx_fifo_dout;
+  wire [31:0] rx_fifo_dout;
+  wire tx_read_req;
   wire [7:0] status_bits;
+  wire [TX_LEVEL_WIDTH - 1:0] tx_fifo_level;
+  wire [RX_LEVEL_WIDTH - 1:0] rx_fifo_level;
   wire clk_div_zero;
   wire spi_busy;
   wire spi_ready;
   wire tx_fifo_wr_en;
+  wire rx_fifo_rd_en;
   wire tx_fifo_empty;
   wire tx_fifo_full;
   wire rx_fifo_empty;
@@ -132,15 +175,20 @@ module spi #(
   assign fifo_full        = rx_fifo_full | tx_fifo_full;
   assign spi_ready        = !spi_busy & tx_fifo_empty & rx_fifo_empty;
   assign status_bits      = {clk_div_zero, fifo_full, spi_ready, spi_busy, rx_fifo_full, rx_fifo_empty, tx_fifo_full, tx_fifo_empty};
-  assign tx_fifo_din[8:0] = write_data[8:0];
-  assign tx_fifo_wr_en    = we && (address[7:0] == TX_OFFSET);
+  assign tx_read_req      = (address[7:0] == TX_READ_OFFSET) ||
+                            ((frame_sel == FRAME_8) && write_data[8]);
+  assign tx_fifo_din      = {frame_sel, tx_read_req, write_data[31:0]};
+  assign tx_fifo_wr_en    = we && ((address[7:0] == TX_OFFSET) ||
+                                   (address[7:0] == TX_READ_OFFSET));
+  assign rx_fifo_rd_en    = re && (address[7:0] == RX_OFFSET);
   assign spi_cs           = cs_gen ? cs : cs_manual;
+  assign tx_full          = tx_fifo_full;
 
   // ---------------------------------------------------------
   // TX-FIFO Instanz
   // ---------------------------------------------------------
   fifo #(
-    .DATA_WIDTH (9),
+    .DATA_WIDTH (35),
     .DEPTH      (FIFO_TX_DEPTH)
   ) spi_tx_fifo (
     .clk   (clk),
@@ -150,14 +198,15 @@ module spi #(
     .din   (tx_fifo_din),
     .dout  (tx_fifo_dout),
     .empty (tx_fifo_empty),
-    .full  (tx_fifo_full)
+    .full  (tx_fifo_full),
+    .level (tx_fifo_level)
   );
 
   // ---------------------------------------------------------
   // RX-FIFO Instanz
   // ---------------------------------------------------------
   fifo #(
-    .DATA_WIDTH (8),
+    .DATA_WIDTH (32),
     .DEPTH      (FIFO_RX_DEPTH)
   ) spi_rx_fifo (
     .clk   (clk),
@@ -167,20 +216,50 @@ module spi #(
     .din   (rx_fifo_din),
     .dout  (rx_fifo_dout),
     .empty (rx_fifo_empty),
-    .full  (rx_fifo_full)
+    .full  (rx_fifo_full),
+    .level (rx_fifo_level)
   );
 
 
   // ---------------------------------------------------------
-  // Lesen aus SPI-Registern (CTRL, CLK, STATUS, RX, CS)
+  // Lesen aus SPI-Registern (CTRL, CLK, STATUS, RX, CS, Füllstände)
   // ---------------------------------------------------------
-  assign read_data = (address[7:0] == CTRL_OFFSET)   ? {30'd0, cs_gen, active} :
+  assign read_data = (address[7:0] == CTRL_OFFSET)   ? {28'd0, frame_sel, cs_gen, active} :
                      (address[7:0] == CLK_OFFSET)    ? {16'd0,    spi_clk_div} :
                      (address[7:0] == STATUS_OFFSET) ? {24'd0,    status_bits} :
-                     (address[7:0] == RX_OFFSET)     ? {24'd0,   rx_fifo_dout} :
+                     (address[7:0] == RX_OFFSET)     ? rx_fifo_dout :
                      (address[7:0] == CS_OFFSET)     ? {31'd0,      cs_manual} :
+                     (address[7:0] == TX_LEVEL_OFFSET) ? {{(32 - TX_LEVEL_WIDTH){1'b0}}, tx_fifo_level} :
+                     (address[7:0] == RX_LEVEL_OFFSET) ? {{(32 - RX_LEVEL_WIDTH){1'b0}}, rx_fifo_level} :
                      32'd0;
 
+  // ---------------------------------------------------------
+  // Ausrichtung des nächsten TX-Eintrags: Daten linksbündig
+  // (MSB des Rahmens in Bit 31) und Index des letzten Bits
+  // ---------------------------------------------------------
+  always @( * )
+  begin
+    case (tx_fifo_dout[34:33])
+      FRAME_16:
+      begin
+        tx_aligned  = {tx_fifo_dout[15:0], 16'd0};
+        tx_last_bit = 5'd15;
+      end
+
+      FRAME_32:
+      begin
+        tx_aligned  = tx_fifo_dout[31:0];
+        tx_last_bit = 5'd31;
+      end
+
+      default:
+      begin
+        tx_aligned  = {tx_fifo_dout[7:0], 24'd0};
+        tx_last_bit = 5'd7;
+      end
+    endcase
+  end
+
   // ---------------------------------------------------------
   // Clock-Divider-Logik: Erzeugung von spi_clk
   // ---------------------------------------------------------
@@ -228,9 +307,11 @@ module spi #(
       cs            <= 1'b1;
       cs_manual     <= 1'b1;
       spi_clk       <= 1'b0;
-      bit_cnt       <= 4'b0;
-      tx_shift      <= 8'b0;
-      rx_shift      <= 8'b0;
+      bit_cnt       <= 5'b0;
+      last_bit      <= 5'd7;
+      tx_shift      <= 32'b0;
+      rx_shift      <= 32'b0;
+      rx_fifo_din   <= 32'b0;
       read_flag     <= 1'b0;
       tx_fifo_rd_en <= 1'b0;
       rx_fifo_wr_en <= 1'b0;
@@ -249,12 +330,12 @@ module spi #(
           cs_manual <= cs_manual_next;
           cs      <= 1'b1;
           spi_clk <= 1'b0;
-          bit_cnt <= 4'b0;
+          bit_cnt <= 5'b0;
 
           if (active && !tx_fifo_empty)
           begin
             cs            <= 1'b0;
-            tx_shift      <= tx_fifo_dout[7:0];
+            tx_shift      <= tx_aligned;
             tx_fifo_rd_en <= 1'b0;
             state         <= STATE_LOAD;
           end
@@ -269,13 +350,14 @@ module spi #(
 
         STATE_LOAD_WAIT:
         begin
-          tx_shift      <= tx_fifo_dout[7:0];
-          read_flag     <= tx_fifo_dout[8];
+          tx_shift      <= tx_aligned;
+          last_bit      <= tx_last_bit;
+          read_flag     <= tx_fifo_dout[32];
           tx_fifo_rd_en <= 1'b0;
-          rx_shift      <= 8'd0;
-          bit_cnt       <= 4'b0;
+          rx_shift      <= 32'd0;
+          bit_cnt       <= 5'b0;
           spi_clk       <= 1'b0;
-          spi_mosi      <= tx_fifo_dout[7];
+          spi_mosi      <= tx_aligned[31];
           state         <= STATE_TRANSFER;
         end
 
@@ -285,21 +367,19 @@ module spi #(
           begin
             if (spi_clk == 0)
             begin
-              spi_clk <= 1'b1;
-
-              if (bit_cnt <= 3'd7)
-              begin
-                rx_shift[3'd7 - bit_cnt[2:0]] <= spi_miso;
-              end
+              spi_clk  <= 1'b1;
+              // Empfangene Bits von rechts einschieben (rechtsbündig)
+              rx_shift <= {rx_shift[30:0], spi_miso};
             end
             else
             begin
               spi_clk <= 1'b0;
 
-              if (bit_cnt < 3'd7)
+              if (bit_cnt < last_bit)
               begin
-                bit_cnt  <= bit_cnt + 4'b1;
-                spi_mosi <= tx_shift[3'd6 - bit_cnt[2: 0]];
+                bit_cnt  <= bit_cnt + 5'b1;
+                spi_mosi <= tx_shift[30];
+                tx_shift <= {tx_shift[30:0], 1'b0};
               end
               else
               begin
@@ -345,6 +425,7 @@ module spi #(
       active          <= 1'b1;
       cs_manual_next  <= 1'b1;
       cs_gen          <= 1'b1;
+      frame_sel       <= FRAME_8;
       spi_clk_div     <= 16'd0;
       new_spi_clk_div <= 16'd0;
     end
@@ -355,8 +436,9 @@ module spi #(
 
         CTRL_OFFSET:
         begin
-          active   <= write_data[0];
-          cs_gen   <= write_data[1];
+          active    <= write_data[0];
+          cs_gen    <= write_data[1];
+          frame_sel <= write_data[3:2];
         end
 
         CLK_OFFSET:
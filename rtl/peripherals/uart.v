@@ -16,6 +16,8 @@
  * - `STATUS_OFFSET` : Statusbits (z. B. FIFO-Zustand, Busy).
  * - `TX_OFFSET`     : Schreiben in die TX-FIFO.
  * - `RX_OFFSET`     : Lesen aus der RX-FIFO.
+ * - `TX_LEVEL_OFFSET`: Anzahl belegter Einträge der TX-FIFO.
+ * - `RX_LEVEL_OFFSET`: Anzahl belegter Einträge der RX-FIFO.
  *
  * @localparam BAUD_DIV_115200 ... BAUD_DIV_300 : Vordefinierte Baudteiler abhängig von `CLK_FREQ`.
  * @localparam DIV_WIDTH                        : Breite der Taktteilerzähler.
@@ -24,6 +26,10 @@
  * @localparam STATUS_OFFSET                    : Offset für Statusbits.
  * @localparam TX_OFFSET                        : Offset zum Schreiben in die TX-FIFO.
  * @localparam RX_OFFSET                        : Offset zum Lesen aus der RX-FIFO.
+ * @localparam TX_LEVEL_OFFSET                  : Offset für den Füllstand der TX-FIFO.
+ * @localparam RX_LEVEL_OFFSET                  : Offset für den Füllstand der RX-FIFO.
+ * @localparam TX_LEVEL_WIDTH                   : Breite des TX-Füllstands.
+ * @localparam RX_LEVEL_WIDTH                   : Breite des RX-Füllstands.
  *
  * @input  clk               Systemtakt
  * @input  rst_n             Asynchrones, aktives-LOW Reset
@@ -35,6 +41,7 @@
  * @output [31:0] read_data  Gelesener Wert aus dem entsprechenden Register
  * @output reg     uart_tx   UART-Ausgangssignal (TX)
  * @input          uart_rx   UART-Eingangssignal (RX)
+ * @output         tx_full   TX-FIFO voll (Taktung des DMA)
  */
 
 module uart #(
@@ -49,7 +56,8 @@ module uart #(
   input  wire        we,
   input  wire        re,
   output reg         uart_tx,
-  input  wire        uart_rx
+  input  wire        uart_rx,
+  output wire        tx_full
 );
 
   // ---------------------------------------------------------
@@ -83,6 +91,14 @@ module uart #(
   localparam STATUS_OFFSET   = 8'h08;
   localparam TX_OFFSET       = 8'h0C;
   localparam RX_OFFSET       = 8'h10;
+  localparam TX_LEVEL_OFFSET = 8'h14;
+  localparam RX_LEVEL_OFFSET = 8'h18;
+
+  // ---------------------------------------------------------
+  // Breite der Füllstände (0..DEPTH)
+  // ---------------------------------------------------------
+  localparam TX_LEVEL_WIDTH  = $clog2(FIFO_TX_DEPTH) + 1;
+  localparam RX_LEVEL_WIDTH  = $clog2(FIFO_RX_DEPTH) + 1;
 
   // ---------------------------------------------------------
   // Zustände für RX/TX State Machines
@@ -129,6 +145,8 @@ module uart #(
   wire [7:0] tx_data;
   wire [7:0] rx_data;
   wire [5:0] status_bits;
+  wire [TX_LEVEL_WIDTH - 1:0] tx_fifo_level;
+  wire [RX_LEVEL_WIDTH - 1:0] rx_fifo_level;
 
   wire tx_fifo_we;
   wire rx_fifo_re;
@@ -191,6 +209,7 @@ module uart #(
   // bit1 = uart_busy
   // bit0 = uart_ready
   assign status_bits  = {uart_ready, uart_busy, rx_fifo_full, rx_fifo_empty, tx_fifo_full, tx_fifo_empty};
+  assign tx_full      = tx_fifo_full;
   
   // ---------------------------------------------------------
   // Erkennung fallende Flanke bei RX (Startbit-Erkennung)
@@ -204,6 +223,8 @@ module uart #(
                         (address[7:0] == BAUD_OFFSET)   ? {28'd0, baud_sel} :
                         (address[7:0] == STATUS_OFFSET) ? {26'd0, status_bits} :
                         (address[7:0] == RX_OFFSET)     ? {23'd0, !rx_fifo_empty, rx_data} :
+                        (address[7:0] == TX_LEVEL_OFFSET) ? {{(32 - TX_LEVEL_WIDTH){1'b0}}, tx_fifo_level} :
+                        (address[7:0] == RX_LEVEL_OFFSET) ? {{(32 - RX_LEVEL_WIDTH){1'b0}}, rx_fifo_level} :
                         32'd0;
 
   // ---------------------------------------------------------
@@ -220,7 +241,8 @@ module uart #(
     .rd_en (tx_fifo_rd),
     .dout  (tx_fifo_dout),
     .empty (tx_fifo_empty),
-    .full  (tx_fifo_full)
+    .full  (tx_fifo_full),
+    .level (tx_fifo_level)
   );
 
 
@@ -238,7 +260,8 @@ module uart #(
     .rd_en (rx_fifo_re),
     .dout  (rx_fifo_dout),
     .empty (rx_fifo_empty),
-    .full  (rx_fifo_full)
+    .full  (rx_fifo_full),
+    .level (rx_fifo_level)
   );
 
   // ---------------------------------------------------------
@@ -55,6 +55,8 @@ module wgr_v_max (
   wire        mem_busy;
   wire        we;
   wire        re;
+  wire        bus_hold;
+  wire        bus_idle;
   
   // ---------------------------------------------------------
   // Beispiel: Lauflicht-Steuerung für GPIO
@@ -89,7 +91,9 @@ module wgr_v_max (
     .read_data  (read_data),
     .we         (we),
     .re         (re),
-    .mem_busy   (mem_busy)
+    .mem_busy   (mem_busy),
+    .bus_hold   (bus_hold),
+    .bus_idle   (bus_idle)
   );
 
   // ---------------------------------------------------------
@@ -105,6 +109,8 @@ module wgr_v_max (
     .we         (we),
     .re         (re),
     .mem_busy   (mem_busy),
+    .bus_hold   (bus_hold),
+    .bus_idle   (bus_idle),
     .uart_tx    (uart_tx),
     .uart_rx    (uart_rx),
     .debug_out  (debug_out),
@@ -5,11 +5,16 @@ Should be used with the output from conv_hex.py.
 <memory_size> is interpreted as the number of 32 bit words in the input hex.
 So for a 8192 byte fram, use a memory_size of 2048.
 
+The word address of each record is honoured, so sparse input from
+conv_hex.py --sparse is filled with zero words. With --sparse the output
+skips zero words as well and uses readmemh @address directives (byte
+addresses) in front of every non-zero run.
+
 Example Conversion:
     :04000400FF81011364 -> FF 81 01 13
 
 Usage:
-    conv_fram.py <input.hex> <output.hex> <memory_size>
+    conv_fram.py <input.hex> <output.hex> <memory_size> [--sparse]
 
 Example:
     conv_fram.py wgr_flat.hex wgr_fram.hex 2048
@@ -19,9 +24,10 @@ Example:
 #!/usr/bin/env python3
 import sys
 
-def convert_quartus_hex_to_readmemh(input_file, output_file, memory_size=2048):
-    memory_size *= 4  # Word count to byte count
-    data_bytes = []
+def convert_quartus_hex_to_readmemh(input_file, output_file, memory_size=2048, sparse=False):
+    memory_bytes = memory_size * 4  # Word count to byte count
+    data_bytes = ["00"] * memory_bytes
+    dropped = 0
     with open(input_file, 'r') as fin:
         for line in fin:
             line = line.strip()
@@ -29,63 +35,70 @@ def convert_quartus_hex_to_readmemh(input_file, output_file, memory_size=2048):
                 continue
 
             rec_len = int(line[1:3], 16)
+            word_address = int(line[3:7], 16)
             record_type = line[7:9]
             
             if record_type == "00":
                 data_str = line[9:9 + rec_len * 2]
                 for i in range(0, len(data_str), 2):
-                    byte = data_str[i:i+2]
-                    data_bytes.append(byte)
+                    index = word_address * 4 + i // 2
+                    if index < memory_bytes:
+                        data_bytes[index] = data_str[i:i+2]
+                    else:
+                        dropped += 1
             elif record_type == "01":  # EOF
                 break
 
-    if len(data_bytes) < memory_size:
-        data_byte_len = len(data_bytes)
-        size_diff = (memory_size - data_byte_len)
-        data_bytes.extend(["00"] * size_diff)
-        print(f"\n - Extended {data_byte_len // 4} instructions with {size_diff // 4} zero words.")
-    elif len(data_bytes) > memory_size:
-        data_byte_len = len(data_bytes)
-        size_diff = data_byte_len - memory_size
-        data_bytes = data_bytes[:memory_size]
-        print(f"\n - Warning: {size_diff // 4} instructions not written")
-        print(f"\n - {data_byte_len} byte needed, but only {memory_size} byte available.")
+    if dropped:
+        print(f"\n - Warning: {dropped // 4} instructions not written")
+        print(f"\n - {memory_bytes + dropped} byte needed, but only {memory_bytes} byte available.")
 
     byte_count = 0
 
     for i in range(len(data_bytes) - 1, -1, -1):
-        if data_bytes[i] == 0:
-            count += 1
+        if data_bytes[i] == "00":
+            byte_count += 1
         else:
             break
 
-    instruction_count = (memory_size - byte_count) // 4
+    instruction_count = (memory_bytes - byte_count) // 4
 
-    print(f"Instructions: {instruction_count} ({memory_size - byte_count} of {memory_size} bytes used).")
+    print(f"Instructions: {instruction_count} ({memory_bytes - byte_count} of {memory_bytes} bytes used).")
 
     with open(output_file, 'w') as fout:
+        in_run = False
         for i in range(0, len(data_bytes), 4):
-            fout.write(" ".join(data_bytes[i:i+4]) + "\n")
+            word = data_bytes[i:i+4]
+            if sparse:
+                if word == ["00"] * 4:
+                    in_run = False
+                    continue
+                if not in_run:
+                    fout.write(f"@{i:X}\n")
+                    in_run = True
+            fout.write(" ".join(word) + "\n")
         print(f"Output file {output_file} written.")
 
 def main():
-    if len(sys.argv) < 3 or len(sys.argv) > 4:
-        print(" - Usage: input.hex output.hex <memory_size>")
+    args = [a for a in sys.argv[1:] if a != "--sparse"]
+    sparse = len(args) != len(sys.argv) - 1
+    if len(args) < 2 or len(args) > 3:
+        print(" - Usage: input.hex output.hex <memory_size> [--sparse]")
         sys.exit(1)
     print("\n  -- quartus ram .hex to verilog readmemh file converter -- ")
-    input_file = sys.argv[1]
-    output_file = sys.argv[2]
+    input_file = args[0]
+    output_file = args[1]
 
     memory_size = 8192  
-    if len(sys.argv) == 4:
+    if len(args) == 3:
         try:
-            memory_size = int(sys.argv[3])
+            memory_size = int(args[2])
         except ValueError:
             print(" - Error: memory_size must be an integer.")
             sys.exit(1)
 
     print(f"Converting {input_file} to {output_file} ({memory_size * 4} bytes)")
-    convert_quartus_hex_to_readmemh(input_file, output_file, memory_size)
+    convert_quartus_hex_to_readmemh(input_file, output_file, memory_size, sparse)
 
 if __name__ == '__main__':
     main()
@@ -24,13 +24,16 @@ needs to be shifted by 0x4000. When the CPU is accessing the memory at
 0x4008, it is actually accessing the physical memory at 0x0008.
 
 Remaining memory is set to 0x00000000 for the whole <memory_depth>.
+With --sparse, zero words are not written at all. Every record carries its
+own address, so the loader leaves them at the RAM default of 0. crt0.s zeroes
+.bss at boot, so the image does not need to contain it.
 An EOF record (:00000001FF) is appended at the end.
 
 Usage:
-    conv_hex.py <input.hex> <output.hex> <shift_amount in hex> <memory_depth>
+    conv_hex.py <input.hex> <output.hex> <shift_amount in hex> <memory_depth> [--sparse]
 
 Example:
-    conv_hex.py wgr.hex wgr_flat.hex 0x4000 8192
+    conv_hex.py wgr.hex wgr_flat.hex 0x4000 8192 --sparse
 
 """
 
@@ -107,10 +110,14 @@ def compute_checksum(byte_count, address, record_type, data_bytes):
     checksum = ((0x100 - (total & 0xFF)) & 0xFF)
     return checksum
 
-def write_memory_hex(memory, output_hex_path):
+def write_memory_hex(memory, output_hex_path, sparse=False):
     bytes_per_word = 4
+    written = 0
     with open(output_hex_path, 'w', newline='\n') as f:
         for i, word in enumerate(memory):
+            if sparse and word == 0:
+                continue
+            written += 1
             address = i
             byte_count = bytes_per_word
             record_type = 0x00
@@ -129,12 +136,15 @@ def write_memory_hex(memory, output_hex_path):
             record += f"{checksum:02X}"
             f.write(record + "\n")
         f.write(":00000001FF\n")
+        if sparse:
+            print(f"Sparse: {written} of {len(memory)} words written.")
         print(f"Output file {output_hex_path} written.")
 
 def main():
-    if len(sys.argv) != 5:
-        print(" - Usage: conv_hex.py <input.hex> <output.hex> <shift_amount in hex> <memory_depth>\n")
+    if len(sys.argv) not in (5, 6) or (len(sys.argv) == 6 and sys.argv[5] != "--sparse"):
+        print(" - Usage: conv_hex.py <input.hex> <output.hex> <shift_amount in hex> <memory_depth> [--sparse]\n")
         sys.exit(1)
+    sparse = len(sys.argv) == 6
 
     print("\n  -- gcc objcopy .hex to quartus ram .hex converter -- ")
     input_file = sys.argv[1]
@@ -155,7 +165,7 @@ def main():
     print(f"Converting {input_file} to {output_file} ({memory_depth * 4} bytes)")
     
     memory = parse_original_ihex(input_file, shift_amount, memory_depth)
-    write_memory_hex(memory, output_file)
+    write_memory_hex(memory, output_file, sparse)
 
 if __name__ == '__main__':
     main()
@@ -8,16 +8,28 @@ set VSIM_PATH=
 set GL_MODE=0
 set VCD_MODE=0
 set QUIET_MODE=0
+set DIV_MODE=0
+set MULT_MODE=0
 
 for %%A in (%*) do (
     if "%%A"=="-gl" set GL_MODE=1
     if "%%A"=="-vcd" set VCD_MODE=1
     if "%%A"=="-q" set QUIET_MODE=1
+    if "%%A"=="-div" set DIV_MODE=1
+    if "%%A"=="-mult" set MULT_MODE=1
 )
 
 pushd "%~dp0..\..\..\WGR-V-MAX"
 
-if "%GL_MODE%"=="1" (
+if "%DIV_MODE%"=="1" (
+    echo Running Divider Testbench:
+
+    set SIM_SCRIPT=run_div_tb.tcl
+) else if "%MULT_MODE%"=="1" (
+    echo Running Multiplier Testbench:
+
+    set SIM_SCRIPT=run_mult_tb.tcl
+) else if "%GL_MODE%"=="1" (
     echo Running Gate-Level Simulation: Generating Netlist
 
     if not exist "%OUTPUT_DIR%" mkdir "%OUTPUT_DIR%"
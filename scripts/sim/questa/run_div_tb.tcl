@@ -0,0 +1,22 @@
+set RTL_PATH "../rtl"
+
+quit -sim
+transcript file sim_div_log.txt
+if {[file exists work]} {
+    echo "Library 'work' already exists. Skipping vlib creation."
+} else {
+    vlib work
+}
+vmap work work
+
+vlog -work work "$RTL_PATH/peripherals/seq_divider.v"
+
+vlog -work work ./tb_sim/seq_divider_tb.v
+
+vopt work.seq_divider_tb work.seq_divider -o seq_divider_opt +acc
+
+vsim -c seq_divider_opt -t 1ps
+
+run -all
+
+quit -f
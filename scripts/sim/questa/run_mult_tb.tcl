@@ -0,0 +1,22 @@
+set RTL_PATH "../rtl"
+
+quit -sim
+transcript file sim_mult_log.txt
+if {[file exists work]} {
+    echo "Library 'work' already exists. Skipping vlib creation."
+} else {
+    vlib work
+}
+vmap work work
+
+vlog -work work "$RTL_PATH/peripherals/seq_multiplier.v"
+
+vlog -work work ./tb_sim/seq_multiplier_tb.v
+
+vopt work.seq_multiplier_tb work.seq_multiplier -o seq_multiplier_opt +acc
+
+vsim -c seq_multiplier_opt -t 1ps
+
+run -all
+
+quit -f
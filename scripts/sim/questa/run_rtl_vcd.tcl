@@ -17,6 +17,7 @@ vlog -work work "$RTL_PATH/register_file.v"
 vlog -work work "$RTL_PATH/wgr_v_max.v"
 
 vlog -work work "$RTL_PATH/peripherals/debug_module.v"
+vlog -work work "$RTL_PATH/peripherals/dma.v"
 vlog -work work "$RTL_PATH/peripherals/fifo.v"
 vlog -work work "$RTL_PATH/peripherals/gpio.v"
 vlog -work work "$RTL_PATH/peripherals/ws2812b.v"
@@ -33,7 +34,7 @@ vlog -work work ./ip/ram1p/ram1p.v
 vlog -work work ./tb_sim/wgr_v_max_tb.v
 
 vopt work.wgr_v_max_tb work.wgr_v_max work.alu work.cpu work.memory work.register_file \
-     work.debug_module work.fifo work.gpio work.seq_divider \
+     work.debug_module work.dma work.fifo work.gpio work.seq_multiplier work.seq_divider \
      work.ws2812b work.peripheral_bus work.pwm_timer work.spi work.system_timer work.uart \
      work.ram1p -o wgr_v_max_opt -L altera_mf_ver -debugdb +acc
 
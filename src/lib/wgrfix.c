@@ -0,0 +1,583 @@
+#include "wgrhal.h"
+#include "wgrfix.h"
+
+#ifdef FIX_HARDWARE_MULT
+#include "wgrhal_ext.h"
+#endif
+
+typedef union
+{
+    float f;
+    uint32_t i;
+} fix_float_union;
+
+// Interne CORDIC-Darstellung: Winkel in Q3.29, Vektoren in Q2.30
+#define FIX_CORDIC_ITER 20
+#define FIX_CORDIC_SHIFT 13
+#define FIX_CORDIC_GAIN 0x26DD3B6A
+
+// Q16_TWO_PI ist um FIX_TWO_PI_ERR / 2^32 größer als 2*Pi
+#define FIX_TWO_PI_ERR 10991
+
+/**
+ * @brief atan(2^-i) in Q3.29 für die CORDIC-Iterationen.
+ */
+static const int32_t fix_cordic_atan[FIX_CORDIC_ITER] = {
+    0x1921FB54, 0x0ED63383, 0x07D6DD7E, 0x03FAB753, 0x01FF55BB,
+    0x00FFEAAE, 0x007FFD55, 0x003FFFAB, 0x001FFFF5, 0x000FFFFF,
+    0x00080000, 0x00040000, 0x00020000, 0x00010000, 0x00008000,
+    0x00004000, 0x00002000, 0x00001000, 0x00000800, 0x00000400,
+};
+
+/**
+ * @brief Koeffizienten c6 bis c1 des Polynoms für 2^f mit f in [0, 1) in Q1.31
+ *        (c0 = 1), relativer Fehler unter 3e-9.
+ */
+static const uint32_t fix_exp2_poly[6] = {
+    0x00071519, 0x0028DA64, 0x013D0C41, 0x071A23C3, 0x1EBFD5A4, 0x58B90AD3,
+};
+
+// Vorzeichenloses 32x32-Bit-Produkt aus wgrlib.c
+uint64_t umul_32x32(uint32_t a, uint32_t b);
+
+/**
+ * @brief Vorzeichenloses 32x32-Bit-Produkt.
+ *
+ * Mit FIX_HARDWARE_MULT über das 64-Bit-Ergebnis des Hardware-Multiplikators,
+ * sonst über umul_32x32 aus wgrlib.c.
+ *
+ * @param lo Erhält die unteren 32 Bit des Produkts.
+ * @return Die oberen 32 Bit des Produkts.
+ */
+static inline uint32_t fix_umul(uint32_t a, uint32_t b, uint32_t *lo)
+{
+#ifdef FIX_HARDWARE_MULT
+    HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = a;
+    HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = b;
+
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
+        ;
+
+    *lo = HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
+    return HWREG32(MULT_BASE_ADDR + RESH_OFFSET);
+#else
+    uint64_t p = umul_32x32(a, b);
+
+    *lo = (uint32_t)p;
+    return (uint32_t)(p >> 32);
+#endif
+}
+
+/**
+ * @brief Vorzeichenbehaftetes 32x32-Bit-Produkt, die oberen 32 Bit werden aus dem
+ *        vorzeichenlosen Produkt korrigiert.
+ */
+static inline int32_t fix_smul(int32_t a, int32_t b, uint32_t *lo)
+{
+    uint32_t hi = fix_umul((uint32_t)a, (uint32_t)b, lo);
+
+    if (a < 0)
+    {
+        hi -= (uint32_t)b;
+    }
+    if (b < 0)
+    {
+        hi -= (uint32_t)a;
+    }
+    return (int32_t)hi;
+}
+
+/**
+ * @brief Schiebe-Subtrahier-Division für den Nachkommaanteil.
+ *
+ * @param rem Rest, muss kleiner als div sein.
+ * @param div Divisor, höchstens 2^31.
+ * @param bits Anzahl der zu berechnenden Nachkommabits.
+ * @return Gerundeter Quotient rem * 2^bits / div.
+ */
+static uint32_t fix_frac_div(uint32_t rem, uint32_t div, uint32_t bits)
+{
+    uint32_t q = 0;
+
+    while (bits--)
+    {
+        rem <<= 1;
+        q <<= 1;
+        if (rem >= div)
+        {
+            rem -= div;
+            q |= 1;
+        }
+    }
+
+    if (rem >= div - rem)
+    {
+        q++;
+    }
+    return q;
+}
+
+/**
+ * @brief Wandelt einen float mit frac_bits Nachkommabits gerundet und gesättigt
+ *        in eine 32-Bit-Festkommazahl um. NaN und Subnormale ergeben 0.
+ */
+static int32_t fix_from_float(float f, int32_t frac_bits)
+{
+    fix_float_union u = {.f = f};
+    uint32_t exp = (u.i >> 23) & 0xFF;
+    uint32_t sign = u.i >> 31;
+    int32_t shift = (int32_t)exp - 150 + frac_bits;
+    uint32_t mag;
+
+    if (exp == 0 || shift < -24 || (exp == 0xFF && (u.i & 0x7FFFFF)))
+    {
+        return 0;
+    }
+    if (shift > 7)
+    {
+        return sign ? (int32_t)0x80000000 : 0x7FFFFFFF;
+    }
+
+    mag = (u.i & 0x7FFFFF) | 0x800000;
+    if (shift >= 0)
+    {
+        mag <<= shift;
+    }
+    else
+    {
+        mag = (mag + (1u << (-shift - 1))) >> -shift;
+    }
+    return sign ? -(int32_t)mag : (int32_t)mag;
+}
+
+/**
+ * @brief Wandelt eine Festkommazahl mit frac_bits Nachkommabits in einen float um.
+ *        Die Skalierung erfolgt direkt über den Exponenten statt per __mulsf3.
+ */
+static float fix_to_float(int32_t x, uint32_t frac_bits)
+{
+    fix_float_union u = {.f = (float)x};
+
+    if (x != 0)
+    {
+        u.i -= frac_bits << 23;
+    }
+    return u.f;
+}
+
+q16_t q16_add(q16_t a, q16_t b)
+{
+    q16_t r = (q16_t)((uint32_t)a + (uint32_t)b);
+
+    if (((a ^ r) & (b ^ r)) < 0)
+    {
+        return (a < 0) ? Q16_MIN : Q16_MAX;
+    }
+    return r;
+}
+
+q16_t q16_sub(q16_t a, q16_t b)
+{
+    q16_t r = (q16_t)((uint32_t)a - (uint32_t)b);
+
+    if (((a ^ b) & (a ^ r)) < 0)
+    {
+        return (a < 0) ? Q16_MIN : Q16_MAX;
+    }
+    return r;
+}
+
+q16_t q16_mul(q16_t a, q16_t b)
+{
+    uint32_t lo;
+    int32_t hi = fix_smul(a, b, &lo);
+    uint32_t rlo = lo + 0x8000;
+
+    hi += (rlo < lo);
+    if (hi > 0x7FFF)
+    {
+        return Q16_MAX;
+    }
+    if (hi < -0x8000)
+    {
+        return Q16_MIN;
+    }
+    return (q16_t)(((uint32_t)hi << 16) | (rlo >> 16));
+}
+
+q16_t q16_div(q16_t a, q16_t b)
+{
+    uint32_t neg = (uint32_t)(a ^ b) >> 31;
+    uint32_t ua = (a < 0) ? -(uint32_t)a : (uint32_t)a;
+    uint32_t ub = (b < 0) ? -(uint32_t)b : (uint32_t)b;
+    uint32_t q;
+    uint32_t mag;
+
+    if (b == 0)
+    {
+        return (a < 0) ? Q16_MIN : Q16_MAX;
+    }
+
+    q = ua / ub;
+    if (q > 0x7FFF)
+    {
+        return neg ? Q16_MIN : Q16_MAX;
+    }
+
+    mag = (q << 16) + fix_frac_div(ua - q * ub, ub, 16);
+    if (mag > 0x7FFFFFFF)
+    {
+        return neg ? Q16_MIN : Q16_MAX;
+    }
+    return neg ? -(q16_t)mag : (q16_t)mag;
+}
+
+q16_t q16_sqrt(q16_t x)
+{
+    uint32_t num = (uint32_t)x;
+    uint32_t result = 0;
+    uint32_t bit;
+
+    if (x <= 0)
+    {
+        return 0;
+    }
+
+    bit = (num & 0xFFF00000) ? (1u << 30) : (1u << 18);
+    while (bit > num)
+    {
+        bit >>= 2;
+    }
+
+    // Erst die oberen 16 Ergebnisbits, dann nach Verschieben des Rests die unteren
+    for (uint32_t n = 0; n < 2; n++)
+    {
+        while (bit)
+        {
+            if (num >= result + bit)
+            {
+                num -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        if (n == 0)
+        {
+            if (num > 0xFFFF)
+            {
+                // Rest passt nicht in 16 Bit, halbes Ergebnisbit vorwegnehmen
+                num -= result;
+                num = (num << 16) - 0x8000;
+                result = (result << 16) + 0x8000;
+            }
+            else
+            {
+                num <<= 16;
+                result <<= 16;
+            }
+            bit = 1u << 14;
+        }
+    }
+
+    if (num > result)
+    {
+        result++;
+    }
+    return (q16_t)result;
+}
+
+void q16_sincos(q16_t angle, q16_t *sin_out, q16_t *cos_out)
+{
+    int32_t flip = 0;
+
+    if (angle > Q16_PI || angle < -Q16_PI)
+    {
+        // Volle Umdrehungen abziehen und den Rundungsfehler von Q16_TWO_PI ausgleichen
+        int32_t k = angle / Q16_TWO_PI;
+        angle = angle - k * Q16_TWO_PI + ((k * FIX_TWO_PI_ERR + 0x8000) >> 16);
+        if (angle > Q16_PI)
+        {
+            angle -= Q16_TWO_PI;
+        }
+        else if (angle < -Q16_PI)
+        {
+            angle += Q16_TWO_PI;
+        }
+    }
+
+    // Auf [-Pi/2, Pi/2] spiegeln, dabei wechselt nur der Kosinus das Vorzeichen
+    if (angle > Q16_HALF_PI)
+    {
+        angle = Q16_PI - angle;
+        flip = 1;
+    }
+    else if (angle < -Q16_HALF_PI)
+    {
+        angle = -Q16_PI - angle;
+        flip = 1;
+    }
+
+    int32_t x = FIX_CORDIC_GAIN;
+    int32_t y = 0;
+    int32_t z = (int32_t)((uint32_t)angle << FIX_CORDIC_SHIFT);
+
+    for (uint32_t i = 0; i < FIX_CORDIC_ITER; i++)
+    {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+
+        if (z >= 0)
+        {
+            x -= dx;
+            y += dy;
+            z -= fix_cordic_atan[i];
+        }
+        else
+        {
+            x += dx;
+            y -= dy;
+            z += fix_cordic_atan[i];
+        }
+    }
+
+    if (sin_out)
+    {
+        *sin_out = (y + (1 << 13)) >> 14;
+    }
+    if (cos_out)
+    {
+        x = (x + (1 << 13)) >> 14;
+        *cos_out = flip ? -x : x;
+    }
+}
+
+q16_t q16_sin(q16_t angle)
+{
+    q16_t s;
+    q16_sincos(angle, &s, NULL);
+    return s;
+}
+
+q16_t q16_cos(q16_t angle)
+{
+    q16_t c;
+    q16_sincos(angle, NULL, &c);
+    return c;
+}
+
+q16_t q16_atan2(q16_t y, q16_t x)
+{
+    uint32_t ux = (x < 0) ? -(uint32_t)x : (uint32_t)x;
+    uint32_t uy = (y < 0) ? -(uint32_t)y : (uint32_t)y;
+    uint32_t m = ux | uy;
+
+    if (m == 0)
+    {
+        return 0;
+    }
+
+    // Betrag auf [2^28, 2^29) bringen: genug Bits für die Genauigkeit und
+    // genug Reserve für die CORDIC-Verstärkung
+    while (m >= (1u << 29))
+    {
+        ux >>= 1;
+        uy >>= 1;
+        m >>= 1;
+    }
+    while (m < (1u << 28))
+    {
+        ux <<= 1;
+        uy <<= 1;
+        m <<= 1;
+    }
+
+    int32_t vx = (int32_t)ux;
+    int32_t vy = (y < 0) ? -(int32_t)uy : (int32_t)uy;
+    int32_t z = 0;
+
+    for (uint32_t i = 0; i < FIX_CORDIC_ITER; i++)
+    {
+        int32_t dx = vy >> i;
+        int32_t dy = vx >> i;
+
+        if (vy > 0)
+        {
+            vx += dx;
+            vy -= dy;
+            z += fix_cordic_atan[i];
+        }
+        else
+        {
+            vx -= dx;
+            vy += dy;
+            z -= fix_cordic_atan[i];
+        }
+    }
+
+    z = (z + (1 << 12)) >> FIX_CORDIC_SHIFT;
+    if (x < 0)
+    {
+        return ((y < 0) ? -Q16_PI : Q16_PI) - z;
+    }
+    return z;
+}
+
+q16_t q16_exp2(q16_t x)
+{
+    int32_t n = x >> 16;
+    uint32_t f = (uint32_t)x << 16;
+    uint32_t p = fix_exp2_poly[0];
+    uint32_t lo;
+    uint32_t shift;
+    uint32_t result;
+
+    if (n >= 15)
+    {
+        return Q16_MAX;
+    }
+    if (n < -16)
+    {
+        return 0;
+    }
+
+    // Horner-Schema mit p in Q1.31 und f in Q0.32
+    for (uint32_t i = 1; i < 6; i++)
+    {
+        p = fix_exp2_poly[i] + fix_umul(p, f, &lo);
+    }
+    p = 0x80000000 + fix_umul(p, f, &lo);
+
+    // 2^f * 2^n von Q1.31 nach Q16.16
+    shift = (uint32_t)(15 - n);
+    result = (p >> shift) + ((p >> (shift - 1)) & 1);
+    if (result > 0x7FFFFFFF)
+    {
+        return Q16_MAX;
+    }
+    return (q16_t)result;
+}
+
+q16_t q16_log2(q16_t x)
+{
+    uint32_t m = (uint32_t)x;
+    int32_t e = 15;
+    uint32_t frac = 0;
+    uint32_t hi;
+    uint32_t lo;
+
+    if (x <= 0)
+    {
+        return Q16_MIN;
+    }
+
+    // Mantisse nach Q1.31 in [1, 2) normieren, e ist der ganzzahlige Anteil
+    while (!(m & 0x80000000))
+    {
+        m <<= 1;
+        e--;
+    }
+
+    // Je Quadrieren ein Nachkommabit, ein Bit mehr zum Runden
+    for (uint32_t i = 0; i < 17; i++)
+    {
+        hi = fix_umul(m, m, &lo);
+        frac <<= 1;
+        if (hi & 0x80000000)
+        {
+            m = hi;
+            frac |= 1;
+        }
+        else
+        {
+            m = (hi << 1) | (lo >> 31);
+        }
+    }
+
+    return Q16_FROM_INT(e) + (q16_t)((frac + 1) >> 1);
+}
+
+q16_t q16_from_float(float f)
+{
+    return fix_from_float(f, 16);
+}
+
+float q16_to_float(q16_t x)
+{
+    return fix_to_float(x, 16);
+}
+
+q31_t q31_add(q31_t a, q31_t b)
+{
+    q31_t r = (q31_t)((uint32_t)a + (uint32_t)b);
+
+    if (((a ^ r) & (b ^ r)) < 0)
+    {
+        return (a < 0) ? Q31_MIN : Q31_MAX;
+    }
+    return r;
+}
+
+q31_t q31_sub(q31_t a, q31_t b)
+{
+    q31_t r = (q31_t)((uint32_t)a - (uint32_t)b);
+
+    if (((a ^ b) & (a ^ r)) < 0)
+    {
+        return (a < 0) ? Q31_MIN : Q31_MAX;
+    }
+    return r;
+}
+
+q31_t q31_mul(q31_t a, q31_t b)
+{
+    uint32_t lo;
+    int32_t hi = fix_smul(a, b, &lo);
+    uint32_t rlo = lo + 0x40000000;
+
+    hi += (rlo < lo);
+    if (hi >= 0x40000000)
+    {
+        return Q31_MAX;
+    }
+    if (hi < -0x40000000)
+    {
+        return Q31_MIN;
+    }
+    return (q31_t)(((uint32_t)hi << 1) | (rlo >> 31));
+}
+
+q31_t q31_div(q31_t a, q31_t b)
+{
+    uint32_t neg = (uint32_t)(a ^ b) >> 31;
+    uint32_t ua = (a < 0) ? -(uint32_t)a : (uint32_t)a;
+    uint32_t ub = (b < 0) ? -(uint32_t)b : (uint32_t)b;
+    uint32_t mag;
+
+    // |a| >= |b| liegt außerhalb von [-1, 1), nur -1.0 ist darstellbar
+    if (ua >= ub)
+    {
+        return neg ? Q31_MIN : Q31_MAX;
+    }
+
+    mag = fix_frac_div(ua, ub, 31);
+    if (mag > 0x7FFFFFFF)
+    {
+        return neg ? Q31_MIN : Q31_MAX;
+    }
+    return neg ? -(q31_t)mag : (q31_t)mag;
+}
+
+q31_t q31_from_float(float f)
+{
+    return fix_from_float(f, 31);
+}
+
+float q31_to_float(q31_t x)
+{
+    return fix_to_float(x, 31);
+}
@@ -0,0 +1,241 @@
+/**
+ * @file wgrfix.h
+ * @brief Festkomma-Arithmetik (Q16.16 und Q1.31) für den WGR-V-Prozessor.
+ *
+ * Diese Header-Datei stellt eine schnelle Alternative zur Software-Gleitkomma-
+ * Arithmetik aus wgrlib.c bereit. Alle Operationen sättigen bei Überlauf statt
+ * überzulaufen. Neben den Grundrechenarten gibt es Quadratwurzel, Sinus, Kosinus
+ * und atan2 per CORDIC, exp2/log2 sowie Umwandlungen von und nach float.
+ *
+ * Mit FIX_HARDWARE_MULT (in wgrhal.h, standardmäßig aus) verwenden alle
+ * Multiplikationen das 64-Bit-Ergebnis des Hardware-Multiplikators. Das Flag
+ * darf nur auf Zielen mit seq_multiplier gesetzt werden.
+ */
+
+#ifndef WGRFIX_H
+#define WGRFIX_H
+
+#include "wgrtypes.h"
+
+/** @typedef q16_t
+ *  @brief Vorzeichenbehaftete Festkommazahl mit 16 Ganzzahl- und 16 Nachkommabits.
+ */
+typedef int32_t q16_t;
+
+/** @typedef q31_t
+ *  @brief Vorzeichenbehaftete Festkommazahl im Bereich [-1, 1) mit 31 Nachkommabits.
+ */
+typedef int32_t q31_t;
+
+/** @def Q16_ONE
+ *  @brief Der Wert 1.0 im Q16.16-Format.
+ */
+#define Q16_ONE ((q16_t)0x00010000)
+/** @def Q16_MAX
+ *  @brief Größter darstellbarer Q16.16-Wert (ca. 32767.99998).
+ */
+#define Q16_MAX ((q16_t)0x7FFFFFFF)
+/** @def Q16_MIN
+ *  @brief Kleinster darstellbarer Q16.16-Wert (-32768.0).
+ */
+#define Q16_MIN ((q16_t)0x80000000)
+/** @def Q16_PI
+ *  @brief Die Kreiszahl Pi im Q16.16-Format.
+ */
+#define Q16_PI ((q16_t)205887)
+/** @def Q16_HALF_PI
+ *  @brief Pi/2 im Q16.16-Format.
+ */
+#define Q16_HALF_PI ((q16_t)102944)
+/** @def Q16_TWO_PI
+ *  @brief 2*Pi im Q16.16-Format.
+ */
+#define Q16_TWO_PI ((q16_t)411775)
+/** @def Q16_E
+ *  @brief Die Eulersche Zahl e im Q16.16-Format.
+ */
+#define Q16_E ((q16_t)178145)
+
+/** @def Q31_MAX
+ *  @brief Größter darstellbarer Q1.31-Wert (ca. 0.9999999995).
+ */
+#define Q31_MAX ((q31_t)0x7FFFFFFF)
+/** @def Q31_MIN
+ *  @brief Kleinster darstellbarer Q1.31-Wert (-1.0).
+ */
+#define Q31_MIN ((q31_t)0x80000000)
+
+/** @def Q16_FROM_INT
+ *  @brief Wandelt eine Ganzzahl ohne Sättigung in das Q16.16-Format um.
+ */
+#define Q16_FROM_INT(x) ((q16_t)((uint32_t)(x) << 16))
+/** @def Q16_TO_INT
+ *  @brief Wandelt einen Q16.16-Wert in eine Ganzzahl um (abgerundet).
+ */
+#define Q16_TO_INT(x) ((int32_t)(x) >> 16)
+
+/**
+ * @brief Addiert zwei Q16.16-Werte mit Sättigung.
+ *
+ * @param a Erster Summand.
+ * @param b Zweiter Summand.
+ * @return a + b, begrenzt auf [Q16_MIN, Q16_MAX].
+ */
+q16_t q16_add(q16_t a, q16_t b);
+
+/**
+ * @brief Subtrahiert zwei Q16.16-Werte mit Sättigung.
+ *
+ * @param a Minuend.
+ * @param b Subtrahend.
+ * @return a - b, begrenzt auf [Q16_MIN, Q16_MAX].
+ */
+q16_t q16_sub(q16_t a, q16_t b);
+
+/**
+ * @brief Multipliziert zwei Q16.16-Werte mit Rundung und Sättigung.
+ *
+ * @param a Erster Faktor.
+ * @param b Zweiter Faktor.
+ * @return a * b, gerundet und begrenzt auf [Q16_MIN, Q16_MAX].
+ */
+q16_t q16_mul(q16_t a, q16_t b);
+
+/**
+ * @brief Dividiert zwei Q16.16-Werte mit Rundung und Sättigung.
+ *
+ * @param a Dividend.
+ * @param b Divisor.
+ * @return a / b, gerundet und begrenzt. Bei b = 0 Q16_MAX bzw. Q16_MIN je nach Vorzeichen von a.
+ */
+q16_t q16_div(q16_t a, q16_t b);
+
+/**
+ * @brief Berechnet die Quadratwurzel eines Q16.16-Werts.
+ *
+ * @param x Radikand.
+ * @return Gerundete Wurzel von x, 0 für x <= 0.
+ */
+q16_t q16_sqrt(q16_t x);
+
+/**
+ * @brief Berechnet Sinus und Kosinus eines Winkels per CORDIC.
+ *
+ * Winkel außerhalb von [-Pi, Pi] werden auf diesen Bereich reduziert.
+ *
+ * @param angle Winkel im Bogenmaß (Q16.16).
+ * @param sin_out Erhält den Sinus, darf NULL sein.
+ * @param cos_out Erhält den Kosinus, darf NULL sein.
+ */
+void q16_sincos(q16_t angle, q16_t *sin_out, q16_t *cos_out);
+
+/**
+ * @brief Berechnet den Sinus eines Winkels.
+ *
+ * @param angle Winkel im Bogenmaß (Q16.16).
+ * @return Sinus von angle.
+ */
+q16_t q16_sin(q16_t angle);
+
+/**
+ * @brief Berechnet den Kosinus eines Winkels.
+ *
+ * @param angle Winkel im Bogenmaß (Q16.16).
+ * @return Kosinus von angle.
+ */
+q16_t q16_cos(q16_t angle);
+
+/**
+ * @brief Berechnet den Winkel des Punkts (x, y) per CORDIC.
+ *
+ * @param y Y-Koordinate.
+ * @param x X-Koordinate.
+ * @return Winkel im Bogenmaß in [-Pi, Pi], 0 für x = y = 0.
+ */
+q16_t q16_atan2(q16_t y, q16_t x);
+
+/**
+ * @brief Berechnet 2 hoch x.
+ *
+ * @param x Exponent (Q16.16).
+ * @return 2^x, Q16_MAX ab x >= 15, 0 unter x < -16.
+ */
+q16_t q16_exp2(q16_t x);
+
+/**
+ * @brief Berechnet den Logarithmus zur Basis 2.
+ *
+ * @param x Argument (Q16.16).
+ * @return log2(x), Q16_MIN für x <= 0.
+ */
+q16_t q16_log2(q16_t x);
+
+/**
+ * @brief Wandelt einen float gerundet und gesättigt in Q16.16 um.
+ *
+ * @param f Umzuwandelnder Wert, NaN ergibt 0.
+ * @return Q16.16-Darstellung von f.
+ */
+q16_t q16_from_float(float f);
+
+/**
+ * @brief Wandelt einen Q16.16-Wert in einen float um.
+ *
+ * @param x Umzuwandelnder Wert.
+ * @return x als float.
+ */
+float q16_to_float(q16_t x);
+
+/**
+ * @brief Addiert zwei Q1.31-Werte mit Sättigung.
+ *
+ * @param a Erster Summand.
+ * @param b Zweiter Summand.
+ * @return a + b, begrenzt auf [Q31_MIN, Q31_MAX].
+ */
+q31_t q31_add(q31_t a, q31_t b);
+
+/**
+ * @brief Subtrahiert zwei Q1.31-Werte mit Sättigung.
+ *
+ * @param a Minuend.
+ * @param b Subtrahend.
+ * @return a - b, begrenzt auf [Q31_MIN, Q31_MAX].
+ */
+q31_t q31_sub(q31_t a, q31_t b);
+
+/**
+ * @brief Multipliziert zwei Q1.31-Werte mit Rundung und Sättigung.
+ *
+ * @param a Erster Faktor.
+ * @param b Zweiter Faktor.
+ * @return a * b, gerundet. -1.0 * -1.0 ergibt Q31_MAX.
+ */
+q31_t q31_mul(q31_t a, q31_t b);
+
+/**
+ * @brief Dividiert zwei Q1.31-Werte mit Rundung und Sättigung.
+ *
+ * @param a Dividend.
+ * @param b Divisor.
+ * @return a / b, begrenzt auf [Q31_MIN, Q31_MAX] (auch für |a| >= |b| und b = 0).
+ */
+q31_t q31_div(q31_t a, q31_t b);
+
+/**
+ * @brief Wandelt einen float gerundet und gesättigt in Q1.31 um.
+ *
+ * @param f Umzuwandelnder Wert, NaN ergibt 0.
+ * @return Q1.31-Darstellung von f.
+ */
+q31_t q31_from_float(float f);
+
+/**
+ * @brief Wandelt einen Q1.31-Wert in einen float um.
+ *
+ * @param x Umzuwandelnder Wert.
+ * @return x als float.
+ */
+float q31_to_float(q31_t x);
+
+#endif // WGRFIX_H
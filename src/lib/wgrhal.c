@@ -23,10 +23,100 @@
 //
 //------------------------------------------------------
 
+/**
+ * @brief Kopiert nwords Wörter von s nach d, jeweils vier Wörter pro Schleifendurchlauf.
+ *
+ * Alle vier Wörter werden zuerst geladen und danach gespeichert, damit
+ * die Schleife auch für vorwärts überlappende Bereiche (d < s) korrekt ist.
+ *
+ * @param d Wortausgerichteter Zielzeiger.
+ * @param s Wortausgerichteter Quellzeiger.
+ * @param nwords Anzahl der zu kopierenden 32-Bit-Wörter.
+ */
+static void mem_copy_words(uint32_t *d, const uint32_t *s, uint32_t nwords)
+{
+    while (nwords >= 4)
+    {
+        uint32_t w0 = s[0];
+        uint32_t w1 = s[1];
+        uint32_t w2 = s[2];
+        uint32_t w3 = s[3];
+        d[0] = w0;
+        d[1] = w1;
+        d[2] = w2;
+        d[3] = w3;
+        d += 4;
+        s += 4;
+        nwords -= 4;
+    }
+    while (nwords--)
+    {
+        *d++ = *s++;
+    }
+}
+
+/**
+ * @brief Kopiert nwords Wörter von einer nicht ausgerichteten Quelle in ein ausgerichtetes Ziel.
+ *
+ * Die Quelle wird nur mit ausgerichteten Wortzugriffen gelesen, zwei
+ * aufeinanderfolgende Wörter werden per Shift zu einem Zielwort zusammengesetzt.
+ * Es werden keine Bytes hinter dem Ende der Quelle gelesen.
+ *
+ * @param d Wortausgerichteter Zielzeiger.
+ * @param s Nicht ausgerichteter Quellzeiger ((s & 3) != 0).
+ * @param nwords Anzahl der zu schreibenden 32-Bit-Wörter.
+ */
+static void mem_copy_shifted(uint32_t *d, const unsigned char *s, uint32_t nwords)
+{
+    uint32_t shift_lo = ((uintptr_t)s & 3) << 3;
+    uint32_t shift_hi = 32 - shift_lo;
+    const uint32_t *ws = (const uint32_t *)((uintptr_t)s & ~(uintptr_t)3);
+    uint32_t lo = *ws++;
+
+    while (nwords >= 2)
+    {
+        uint32_t mid = ws[0];
+        uint32_t hi = ws[1];
+        d[0] = (lo >> shift_lo) | (mid << shift_hi);
+        d[1] = (mid >> shift_lo) | (hi << shift_hi);
+        lo = hi;
+        ws += 2;
+        d += 2;
+        nwords -= 2;
+    }
+    if (nwords)
+    {
+        *d = (lo >> shift_lo) | (*ws << shift_hi);
+    }
+}
+
 void *memcpy(void *dest, const void *src, uint32_t n)
 {
     unsigned char *d = (unsigned char *)dest;
     const unsigned char *s = (const unsigned char *)src;
+
+    if (n >= MEM_WORD_THRESHOLD)
+    {
+        while ((uintptr_t)d & 3)
+        {
+            *d++ = *s++;
+            n--;
+        }
+
+        uint32_t word_bytes = n & ~(uint32_t)3;
+        if (((uintptr_t)s & 3) == 0)
+        {
+            mem_copy_words((uint32_t *)d, (const uint32_t *)s, n >> 2);
+        }
+        else
+        {
+            mem_copy_shifted((uint32_t *)d, s, n >> 2);
+        }
+        d += word_bytes;
+        s += word_bytes;
+        n &= 3;
+    }
+
     while (n--)
     {
         *d++ = *s++;
@@ -37,6 +127,38 @@ void *memcpy(void *dest, const void *src, uint32_t n)
 void *memset(void *dest, int32_t c, uint32_t n)
 {
     unsigned char *d = (unsigned char *)dest;
+
+    if (n >= MEM_WORD_THRESHOLD)
+    {
+        while ((uintptr_t)d & 3)
+        {
+            *d++ = (unsigned char)c;
+            n--;
+        }
+
+        uint32_t pattern = (unsigned char)c;
+        pattern |= pattern << 8;
+        pattern |= pattern << 16;
+
+        uint32_t *wd = (uint32_t *)d;
+        uint32_t nwords = n >> 2;
+        while (nwords >= 4)
+        {
+            wd[0] = pattern;
+            wd[1] = pattern;
+            wd[2] = pattern;
+            wd[3] = pattern;
+            wd += 4;
+            nwords -= 4;
+        }
+        while (nwords--)
+        {
+            *wd++ = pattern;
+        }
+        d = (unsigned char *)wd;
+        n &= 3;
+    }
+
     while (n--)
     {
         *d++ = (unsigned char)c;
@@ -48,21 +170,58 @@ void *memmove(void *dest, const void *src, uint32_t n)
 {
     unsigned char *d = (unsigned char *)dest;
     const unsigned char *s = (const unsigned char *)src;
-    if (d < s)
+
+    if (d == s || n == 0)
     {
-        while (n--)
-        {
-            *d++ = *s++;
-        }
+        return dest;
+    }
+
+    // Vorwärtskopie ist sicher, solange dest nicht im hinteren Teil von src liegt
+    if (d < s || d >= s + n)
+    {
+        return memcpy(dest, src, n);
     }
-    else if (d > s)
+
+    d += n;
+    s += n;
+
+    if (n >= MEM_WORD_THRESHOLD && (((uintptr_t)d ^ (uintptr_t)s) & 3) == 0)
     {
-        d += n;
-        s += n;
-        while (n--)
+        while ((uintptr_t)d & 3)
         {
             *(--d) = *(--s);
+            n--;
+        }
+
+        uint32_t *wd = (uint32_t *)d;
+        const uint32_t *ws = (const uint32_t *)s;
+        uint32_t nwords = n >> 2;
+        while (nwords >= 4)
+        {
+            uint32_t w3 = ws[-1];
+            uint32_t w2 = ws[-2];
+            uint32_t w1 = ws[-3];
+            uint32_t w0 = ws[-4];
+            wd[-1] = w3;
+            wd[-2] = w2;
+            wd[-3] = w1;
+            wd[-4] = w0;
+            wd -= 4;
+            ws -= 4;
+            nwords -= 4;
+        }
+        while (nwords--)
+        {
+            *(--wd) = *(--ws);
         }
+        d = (unsigned char *)wd;
+        s = (const unsigned char *)ws;
+        n &= 3;
+    }
+
+    while (n--)
+    {
+        *(--d) = *(--s);
     }
     return dest;
 }
@@ -73,18 +232,107 @@ void *memmove(void *dest, const void *src, uint32_t n)
 //
 //------------------------------------------------------
 
+/**
+ * @brief Vergleicht zwei Strings wortweise, solange die Wörter gleich sind und kein Nullbyte enthalten.
+ *
+ * s1 muss wortausgerichtet sein. Ist s2 anders ausgerichtet, werden zwei
+ * ausgerichtete Wörter von s2 per Shift zusammengesetzt. Das nächste Wort von
+ * s2 wird erst gelesen, wenn im aktuellen Wort kein Nullbyte mehr liegt.
+ *
+ * @param s1 Wortausgerichteter erster String.
+ * @param s2 Zweiter String.
+ * @param max_words Maximale Anzahl zu vergleichender Wörter.
+ * @return Anzahl der Bytes (Vielfaches von 4), die gleich und ungleich 0 sind.
+ */
+static uint32_t str_equal_words(const char *s1, const char *s2, uint32_t max_words)
+{
+    const uint32_t *w1 = (const uint32_t *)s1;
+    uint32_t words = 0;
+
+    if (((uintptr_t)s2 & 3) == 0)
+    {
+        const uint32_t *w2 = (const uint32_t *)s2;
+        while (words < max_words)
+        {
+            uint32_t a = w1[words];
+            if (a != w2[words] || SWAR_HAS_ZERO(a))
+            {
+                break;
+            }
+            words++;
+        }
+    }
+    else
+    {
+        uint32_t shift_lo = ((uintptr_t)s2 & 3) << 3;
+        uint32_t shift_hi = 32 - shift_lo;
+        uint32_t lo_mask = ((uint32_t)1 << shift_lo) - 1;
+        const uint32_t *w2 = (const uint32_t *)((uintptr_t)s2 & ~(uintptr_t)3);
+        uint32_t lo = w2[0];
+
+        while (words < max_words)
+        {
+            if (SWAR_HAS_ZERO(lo | lo_mask))
+            {
+                break;
+            }
+            uint32_t hi = w2[words + 1];
+            uint32_t a = w1[words];
+            if (a != ((lo >> shift_lo) | (hi << shift_hi)) || SWAR_HAS_ZERO(a))
+            {
+                break;
+            }
+            lo = hi;
+            words++;
+        }
+    }
+
+    return words << 2;
+}
+
 uint32_t strlen(const char *s)
 {
-    uint32_t len = 0;
-    while (*s++)
+    const char *p = s;
+
+    while ((uintptr_t)p & 3)
     {
-        len++;
+        if (*p == '\0')
+        {
+            return (uint32_t)(p - s);
+        }
+        p++;
     }
-    return len;
+
+    const uint32_t *w = (const uint32_t *)p;
+    while (!SWAR_HAS_ZERO(*w))
+    {
+        w++;
+    }
+
+    p = (const char *)w;
+    while (*p)
+    {
+        p++;
+    }
+    return (uint32_t)(p - s);
 }
 
 int32_t strcmp(const char *s1, const char *s2)
 {
+    while ((uintptr_t)s1 & 3)
+    {
+        if (*s1 == '\0' || *s1 != *s2)
+        {
+            return (int)((unsigned char)*s1 - (unsigned char)*s2);
+        }
+        s1++;
+        s2++;
+    }
+
+    uint32_t skip = str_equal_words(s1, s2, 0xFFFFFFFF);
+    s1 += skip;
+    s2 += skip;
+
     while (*s1 && (*s1 == *s2))
     {
         s1++;
@@ -95,6 +343,22 @@ int32_t strcmp(const char *s1, const char *s2)
 
 int32_t strncmp(const char *s1, const char *s2, uint32_t n)
 {
+    while (n && ((uintptr_t)s1 & 3))
+    {
+        if (*s1 == '\0' || *s1 != *s2)
+        {
+            return (int)((unsigned char)*s1 - (unsigned char)*s2);
+        }
+        s1++;
+        s2++;
+        n--;
+    }
+
+    uint32_t skip = str_equal_words(s1, s2, n >> 2);
+    s1 += skip;
+    s2 += skip;
+    n -= skip;
+
     while (n && *s1 && (*s1 == *s2))
     {
         s1++;
@@ -114,52 +378,194 @@ int32_t strncmp(const char *s1, const char *s2, uint32_t n)
 char *strcpy(char *dest, const char *src)
 {
     char *d = dest;
+
+    while ((uintptr_t)src & 3)
+    {
+        if ((*d++ = *src++) == '\0')
+        {
+            return dest;
+        }
+    }
+
+    const uint32_t *ws = (const uint32_t *)src;
+    uint32_t w = *ws;
+
+    if (((uintptr_t)d & 3) == 0)
+    {
+        uint32_t *wd = (uint32_t *)d;
+        while (!SWAR_HAS_ZERO(w))
+        {
+            *wd++ = w;
+            w = *(++ws);
+        }
+        d = (char *)wd;
+    }
+    else
+    {
+        while (!SWAR_HAS_ZERO(w))
+        {
+            d[0] = (char)w;
+            d[1] = (char)(w >> 8);
+            d[2] = (char)(w >> 16);
+            d[3] = (char)(w >> 24);
+            d += 4;
+            w = *(++ws);
+        }
+    }
+
+    src = (const char *)ws;
     while ((*d++ = *src++))
         ;
     return dest;
 }
 
-void int_to_str(int32_t num, int base, char *str)
+/**
+ * @brief Teilt n durch 10 ohne Division.
+ *
+ * Multipliziert n mit 0.1 (0xCCCCCCCD / 2^35) über Shifts und Additionen,
+ * da der Kern keinen Hardware-Multiplizierer besitzt. Der Näherungsfehler
+ * von höchstens 1 wird über den Rest korrigiert.
+ *
+ * @param n Dividend.
+ * @param rem Zeiger, in den der Rest (0-9) geschrieben wird.
+ * @return n / 10.
+ */
+static inline uint32_t fmt_divmod10(uint32_t n, uint32_t *rem)
 {
-    char temp[35];
-    int i = 0, j = 0;
-    int is_negative = 0;
+    uint32_t q = (n >> 1) + (n >> 2);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q >>= 3;
+    uint32_t r = n - (((q << 2) + q) << 1);
+    if (r > 9)
+    {
+        q++;
+        r -= 10;
+    }
+    *rem = r;
+    return q;
+}
 
-    if (base < 2 || base > 16)
+static const char fmt_hex_digits[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+uint32_t fmt_u32_dec(uint32_t num, char *buf)
+{
+    char temp[FMT_U32_DEC_LEN];
+    uint32_t i = 0;
+    uint32_t len = 0;
+
+    do
     {
-        str[0] = '\0';
-        return;
+        uint32_t digit;
+        num = fmt_divmod10(num, &digit);
+        temp[i++] = (char)('0' + digit);
+    } while (num != 0);
+
+    while (i > 0)
+    {
+        buf[len++] = temp[--i];
     }
+    buf[len] = '\0';
+    return len;
+}
+
+uint32_t fmt_u32_hex(uint32_t num, char *buf)
+{
+    uint32_t shift = 28;
+    uint32_t len = 0;
 
-    if (num == 0)
+    while (shift > 0 && ((num >> shift) & 0xF) == 0)
     {
-        str[j++] = '0';
-        str[j] = '\0';
-        return;
+        shift -= 4;
     }
 
-    if (num < 0 && base == 10)
+    for (;;)
     {
-        num = -num;
+        buf[len++] = fmt_hex_digits[(num >> shift) & 0xF];
+        if (shift == 0)
+        {
+            break;
+        }
+        shift -= 4;
     }
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Formatiert eine vorzeichenlose Zahl in einer beliebigen Basis (2-16).
+ *
+ * Basis 10 und 16 werden an fmt_u32_dec und fmt_u32_hex weitergereicht,
+ * Zweierpotenzen werden per Shift zerlegt. Nur die übrigen Basen benötigen
+ * die generische Division.
+ *
+ * @param num Zu formatierende Zahl.
+ * @param base Zahlensystembasis (2-16).
+ * @param buf Zielpuffer (mindestens 33 Byte).
+ * @return Anzahl der geschriebenen Zeichen ohne Nullzeichen.
+ */
+static uint32_t fmt_u32_base(uint32_t num, uint32_t base, char *buf)
+{
+    char temp[33];
+    uint32_t i = 0;
+    uint32_t len = 0;
 
-    while (num != 0)
+    if (base == 10)
+    {
+        return fmt_u32_dec(num, buf);
+    }
+    if (base == 16)
     {
-        int rem = num % base;
-        temp[i++] = (rem > 9) ? (rem - 10) + 'A' : rem + '0';
-        num /= base;
+        return fmt_u32_hex(num, buf);
     }
 
-    if (is_negative)
+    if ((base & (base - 1)) == 0)
     {
-        temp[i++] = '-';
+        uint32_t bits = (base == 2) ? 1 : (base == 4) ? 2 : 3;
+        uint32_t mask = base - 1;
+        do
+        {
+            temp[i++] = fmt_hex_digits[num & mask];
+            num >>= bits;
+        } while (num != 0);
+    }
+    else
+    {
+        do
+        {
+            temp[i++] = fmt_hex_digits[num % base];
+            num /= base;
+        } while (num != 0);
     }
 
     while (i > 0)
     {
-        str[j++] = temp[--i];
+        buf[len++] = temp[--i];
     }
-    str[j] = '\0';
+    buf[len] = '\0';
+    return len;
+}
+
+void int_to_str(int32_t num, int base, char *str)
+{
+    uint32_t value = (uint32_t)num;
+
+    if (base < 2 || base > 16)
+    {
+        str[0] = '\0';
+        return;
+    }
+
+    if (num < 0 && base == 10)
+    {
+        *str++ = '-';
+        value = (uint32_t)0 - value;
+    }
+
+    fmt_u32_base(value, (uint32_t)base, str);
 }
 
 int32_t parse_integer(const char *str)
@@ -310,6 +716,16 @@ uint32_t uart_tx_empty(void)
     return ((uart_get_status() >> 0) & (uint32_t)1);
 }
 
+uint32_t uart_tx_free(void)
+{
+    return UART_TX_FIFO_DEPTH - HWREG32(UART_BASE_ADDR + UART_TX_LEVEL_OFFSET);
+}
+
+uint32_t uart_rx_avail(void)
+{
+    return HWREG32(UART_BASE_ADDR + UART_RX_LEVEL_OFFSET);
+}
+
 int32_t uart_wait_tx_full(uint32_t timeout_ms)
 {
     uint32_t start_time = millis();
@@ -331,6 +747,9 @@ int32_t uart_wait_rx_data(uint32_t timeout_ms)
 
     while (uart_rx_empty())
     {
+#ifdef UART_TX_BUFFER
+        uart_flush_pending();
+#endif
         if ((millis() - start_time) >= timeout_ms)
         {
             return -1;
@@ -342,6 +761,9 @@ int32_t uart_wait_rx_data(uint32_t timeout_ms)
 
 int32_t uart_write_byte(uint8_t data, uint32_t timeout_ms)
 {
+#ifdef UART_TX_BUFFER
+    return uart_write_buffered(&data, 1, timeout_ms);
+#else
     if (uart_tx_full())
     {
         int32_t ret = uart_wait_tx_full(timeout_ms);
@@ -351,9 +773,9 @@ int32_t uart_write_byte(uint8_t data, uint32_t timeout_ms)
         }
     }
 
-    uart_tx_full();
     HWREG32(UART_BASE_ADDR + UART_TX_OFFSET) = (uint32_t)data;
     return 0;
+#endif
 }
 
 int32_t uart_putchar(char c, uint32_t timeout_ms)
@@ -373,6 +795,9 @@ int32_t uart_write_buffer(const uint8_t *buffer, uint32_t length, uint32_t timeo
         return -1;
     }
 
+#ifdef UART_TX_BUFFER
+    return uart_write_buffered(buffer, length, timeout_ms);
+#else
     for (uint32_t i = 0; i < length; i++)
     {
         int32_t ret = uart_write_byte(buffer[i], timeout_ms);
@@ -383,6 +808,7 @@ int32_t uart_write_buffer(const uint8_t *buffer, uint32_t length, uint32_t timeo
     }
 
     return 0;
+#endif
 }
 
 int32_t uart_read_byte(uint8_t *data, uint32_t timeout_ms)
@@ -413,12 +839,26 @@ int32_t uart_read_buffer(uint8_t *buf, uint32_t length, uint32_t timeout_ms)
     {
         return -1;
     }
-    for (uint32_t i = 0; i < length; i++)
+
+    uint32_t i = 0;
+    while (i < length)
     {
-        int32_t ret = uart_read_byte(&buf[i], timeout_ms);
-        if (ret < 0)
+        uint32_t avail = uart_rx_avail();
+
+        if (avail == 0)
         {
-            return ret;
+            int32_t ret = uart_wait_rx_data(timeout_ms);
+            if (ret < 0)
+            {
+                return ret;
+            }
+            continue;
+        }
+
+        while (avail && i < length)
+        {
+            buf[i++] = (uint8_t)HWREG32(UART_BASE_ADDR + UART_RX_OFFSET);
+            avail--;
         }
     }
     return 0;
@@ -444,45 +884,136 @@ void uart_print_uint(uint32_t num, int32_t base)
         return;
     }
 
-    if (num == 0)
+    fmt_u32_base(num, (uint32_t)base, buffer);
+    uart_print(buffer);
+}
+
+void uart_print_int(int32_t num)
+{
+    char buffer[FMT_U32_DEC_LEN + 1];
+
+    int_to_str(num, 10, buffer);
+    uart_print(buffer);
+}
+
+void uart_print(const char *s)
+{
+#ifdef UART_TX_BUFFER
+    // Rest im Software-Puffer sofort nachschieben, sonst bleibt er z. B. vor einem Halt liegen
+    if (uart_write_buffered((const uint8_t *)s, strlen(s), DEFAULT_TIMEOUT) == 0)
     {
-        uart_putchar_default_timeout('0');
-        return;
+        uart_tx_drain(DEFAULT_TIMEOUT);
     }
-
-    int i = 0;
-    while (num > 0)
+#else
+    while (*s)
     {
-        uint32_t digit = num % base;
-        buffer[i++] = (digit < 10) ? ('0' + digit) : ('A' + (digit - 10));
-        num /= base;
+        uart_putchar_default_timeout(*s++);
     }
+#endif
+}
+
+#ifdef UART_TX_BUFFER
 
-    while (i--)
+static uint8_t uart_tx_ring[UART_TX_RING_SIZE];
+static uint32_t uart_tx_head = 0;
+static uint32_t uart_tx_tail = 0;
+
+uint32_t uart_flush_pending(void)
+{
+    while (uart_tx_head != uart_tx_tail)
     {
-        uart_putchar_default_timeout(buffer[i]);
+        uint32_t room = uart_tx_free();
+
+        if (room == 0)
+        {
+            break;
+        }
+
+        while (room && uart_tx_head != uart_tx_tail)
+        {
+            HWREG32(UART_BASE_ADDR + UART_TX_OFFSET) =
+                (uint32_t)uart_tx_ring[uart_tx_tail & (UART_TX_RING_SIZE - 1)];
+            uart_tx_tail++;
+            room--;
+        }
     }
+
+    return uart_tx_head - uart_tx_tail;
 }
 
-void uart_print_int(int32_t num)
+uint32_t uart_tx_pending(void)
 {
-    if (num < 0)
+    return uart_tx_head - uart_tx_tail;
+}
+
+uint32_t uart_tx_enqueue(const uint8_t *buffer, uint32_t length)
+{
+    uint32_t space = UART_TX_RING_SIZE - (uart_tx_head - uart_tx_tail);
+    uint32_t count = (length < space) ? length : space;
+    uint32_t head = uart_tx_head;
+
+    for (uint32_t i = 0; i < count; i++)
     {
-        uart_putchar_default_timeout('-');
-        num = -num;
+        uart_tx_ring[head & (UART_TX_RING_SIZE - 1)] = buffer[i];
+        head++;
     }
 
-    uart_print_uint((uint32_t)num, 10);
+    uart_tx_head = head;
+    return count;
 }
 
-void uart_print(const char *s)
+int32_t uart_write_buffered(const uint8_t *buffer, uint32_t length, uint32_t timeout_ms)
 {
-    while (*s)
+    uint32_t start_time = 0;
+    uint32_t stalled = 0;
+
+    while (1)
     {
-        uart_putchar_default_timeout(*s++);
+        uint32_t queued = uart_tx_enqueue(buffer, length);
+        uint32_t tail = uart_tx_tail;
+
+        buffer += queued;
+        length -= queued;
+
+        uart_flush_pending();
+
+        if (length == 0)
+        {
+            return 0;
+        }
+
+        if (queued != 0 || tail != uart_tx_tail)
+        {
+            stalled = 0;
+        }
+        else if (!stalled)
+        {
+            start_time = millis();
+            stalled = 1;
+        }
+        else if ((millis() - start_time) >= timeout_ms)
+        {
+            return -1;
+        }
+    }
+}
+
+int32_t uart_tx_drain(uint32_t timeout_ms)
+{
+    uint32_t start_time = millis();
+
+    while (uart_flush_pending())
+    {
+        if ((millis() - start_time) >= timeout_ms)
+        {
+            return -1;
+        }
     }
+    return 0;
 }
 
+#endif
+
 // ----------------------- WGR-V -----------------------
 //
 //                    Zeit Funktionen
@@ -547,6 +1078,9 @@ void delay(uint32_t ms)
     uint32_t start_time = millis();
     while ((millis() - start_time) < ms)
     {
+#ifdef UART_TX_BUFFER
+        uart_flush_pending();
+#endif
         nop();
     }
 }
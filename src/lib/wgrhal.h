@@ -10,8 +10,15 @@
 #define WGRHAL_H
 
 #define MALLOC
+#define MALLOC_TLSF
+//#define HEAP_TRACE
 #define PWM_NOTES
 #define SSD1351
+#define UART_TX_BUFFER
+#define DMA
+// Nur für Builds mit seq_multiplier (RV32I_quartus), der FRAM-ASIC hat keinen
+//#define UDIV_HW_MULT
+//#define FIX_HARDWARE_MULT
 
 #include "wgrtypes.h"
 
@@ -61,6 +68,26 @@
  *  @brief Offset für das UART-Empfangsregister.
  */
 #define UART_RX_OFFSET 0x10
+/** @def UART_TX_LEVEL_OFFSET
+ *  @brief Offset für den Füllstand des UART-Sende-FIFOs.
+ */
+#define UART_TX_LEVEL_OFFSET 0x14
+/** @def UART_RX_LEVEL_OFFSET
+ *  @brief Offset für den Füllstand des UART-Empfangs-FIFOs.
+ */
+#define UART_RX_LEVEL_OFFSET 0x18
+/** @def UART_STATUS_TX_EMPTY
+ *  @brief Statusbit: Sende-FIFO ist leer.
+ */
+#define UART_STATUS_TX_EMPTY (1U << 0)
+/** @def UART_STATUS_TX_FULL
+ *  @brief Statusbit: Sende-FIFO ist voll.
+ */
+#define UART_STATUS_TX_FULL (1U << 1)
+/** @def UART_TX_FIFO_DEPTH
+ *  @brief Tiefe des Hardware-Sende-FIFOs (UART_FIFO_TX_DEPTH in defines.v).
+ */
+#define UART_TX_FIFO_DEPTH 4
 
 /** @def TIME_BASE_ADDR
  *  @brief Basisadresse für Zeitfunktionen.
@@ -138,6 +165,31 @@
  */
 #define DEFAULT_TIMEOUT 10
 
+/** @def UART_TX_RING_SIZE
+ *  @brief Größe des Software-Sendepuffers in Byte (Zweierpotenz).
+ */
+#define UART_TX_RING_SIZE 64
+
+/** @def MEM_WORD_THRESHOLD
+ *  @brief Ab dieser Länge in Byte kopieren/setzen die Speicherfunktionen wortweise.
+ */
+#define MEM_WORD_THRESHOLD 8
+
+/** @def SWAR_HAS_ZERO
+ *  @brief Ungleich 0, wenn eines der vier Bytes des 32-Bit-Werts x gleich 0 ist.
+ */
+#define SWAR_HAS_ZERO(x) (((x) - 0x01010101U) & ~(x) & 0x80808080U)
+
+/** @def FMT_U32_DEC_LEN
+ *  @brief Puffergröße für fmt_u32_dec (10 Ziffern und Nullzeichen).
+ */
+#define FMT_U32_DEC_LEN 11
+
+/** @def FMT_U32_HEX_LEN
+ *  @brief Puffergröße für fmt_u32_hex (8 Ziffern und Nullzeichen).
+ */
+#define FMT_U32_HEX_LEN 9
+
 /* Standard Memory Functions */
 /**
  * @brief Kopiert n Bytes von src nach dest.
@@ -169,6 +221,29 @@ void *memset(void *dest, int32_t c, uint32_t n);
  */
 void *memmove(void *dest, const void *src, uint32_t n);
 
+/**
+ * @brief Handoptimierte Assembler-Variante von memcpy (wgrmem.S).
+ *
+ * Gleich ausgerichtete Puffer werden in 16-Byte-Blöcken kopiert, bei
+ * unterschiedlicher Ausrichtung wird an memcpy weitergeleitet.
+ *
+ * @param dest Zielpuffer, in den die Bytes kopiert werden.
+ * @param src Quellpuffer, von dem die Bytes gelesen werden.
+ * @param n Anzahl der zu kopierenden Bytes.
+ * @return Zeiger auf den Zielpuffer.
+ */
+void *memcpy_asm(void *dest, const void *src, uint32_t n);
+
+/**
+ * @brief Handoptimierte Assembler-Variante von memset (wgrmem.S).
+ *
+ * @param dest Zielpuffer, in dem der Wert gesetzt wird.
+ * @param c Zu setzender Wert.
+ * @param n Anzahl der Bytes, die gesetzt werden.
+ * @return Zeiger auf den Zielpuffer.
+ */
+void *memset_asm(void *dest, int32_t c, uint32_t n);
+
 /* Standard String Functions */
 /**
  * @brief Bestimmt die Länge eines Strings.
@@ -215,6 +290,27 @@ char *strcpy(char *dest, const char *src);
  */
 void int_to_str(int32_t num, int base, char *str);
 
+/**
+ * @brief Formatiert eine vorzeichenlose Zahl dezimal ohne generische Division.
+ *
+ * Die Ziffern werden über eine Reziproken-Multiplikation mit 0.1 aus Shifts
+ * und Additionen bestimmt, __udivsi3/__umodsi3 werden nicht aufgerufen.
+ *
+ * @param num Zu formatierende Zahl.
+ * @param buf Zielpuffer mit mindestens FMT_U32_DEC_LEN Byte.
+ * @return Anzahl der geschriebenen Zeichen ohne Nullzeichen.
+ */
+uint32_t fmt_u32_dec(uint32_t num, char *buf);
+
+/**
+ * @brief Formatiert eine vorzeichenlose Zahl hexadezimal (Großbuchstaben, ohne Präfix).
+ *
+ * @param num Zu formatierende Zahl.
+ * @param buf Zielpuffer mit mindestens FMT_U32_HEX_LEN Byte.
+ * @return Anzahl der geschriebenen Zeichen ohne Nullzeichen.
+ */
+uint32_t fmt_u32_hex(uint32_t num, char *buf);
+
 /**
  * @brief Parst einen String in eine Ganzzahl.
  *
@@ -307,6 +403,20 @@ uint32_t uart_tx_full(void);
  */
 uint32_t uart_tx_empty(void);
 
+/**
+ * @brief Liefert die Anzahl freier Plätze im Sende-FIFO.
+ *
+ * @return Anzahl der Bytes, die ohne Warten geschrieben werden können.
+ */
+uint32_t uart_tx_free(void);
+
+/**
+ * @brief Liefert die Anzahl der Bytes im Empfangs-FIFO.
+ *
+ * @return Anzahl der Bytes, die ohne Warten gelesen werden können.
+ */
+uint32_t uart_rx_avail(void);
+
 /**
  * @brief Wartet darauf, dass der Sende-Puffer voll wird, bis zu einer Zeitüberschreitung.
  *
@@ -411,10 +521,68 @@ void uart_print_int(int32_t num);
 /**
  * @brief Gibt einen String über die UART aus.
  *
+ * Mit UART_TX_BUFFER kehrt die Funktion erst zurück, wenn der
+ * Software-Sendepuffer an den Hardware-FIFO übergeben ist.
+ *
  * @param s Zu druckender String.
  */
 void uart_print(const char *s);
 
+#ifdef UART_TX_BUFFER
+
+/**
+ * @brief Schiebt wartende Bytes aus dem Software-Sendepuffer in den Hardware-FIFO.
+ *
+ * Blockiert nicht. Pro Lesen des Füllstands werden so viele Bytes
+ * geschrieben, wie der Hardware-FIFO aufnehmen kann.
+ *
+ * @return Anzahl der noch im Software-Puffer wartenden Bytes.
+ */
+uint32_t uart_flush_pending(void);
+
+/**
+ * @brief Liefert die Anzahl der im Software-Sendepuffer wartenden Bytes.
+ *
+ * @return Anzahl der wartenden Bytes.
+ */
+uint32_t uart_tx_pending(void);
+
+/**
+ * @brief Legt so viele Bytes wie möglich im Software-Sendepuffer ab, ohne zu warten.
+ *
+ * @param buffer Zeiger auf die zu sendenden Daten.
+ * @param length Anzahl der Bytes.
+ * @return Anzahl der übernommenen Bytes.
+ */
+uint32_t uart_tx_enqueue(const uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief Sendet einen Puffer über den Software-Sendepuffer.
+ *
+ * Schiebt so viele Bytes wie möglich in den Hardware-FIFO und kehrt zurück,
+ * sobald der Rest im Software-Puffer liegt. Dieser Rest wird erst von einem
+ * späteren Schreibzugriff, delay, uart_wait_rx_data oder uart_tx_drain
+ * gesendet; vor einem Halt oder einer langen Rechenschleife muss daher
+ * uart_tx_drain aufgerufen werden. Das Zeitlimit gilt nur, solange die
+ * Hardware keine Bytes annimmt.
+ *
+ * @param buffer Zeiger auf die zu sendenden Daten.
+ * @param length Anzahl der Bytes.
+ * @param timeout_ms Zeitlimit in Millisekunden.
+ * @return 0 bei Erfolg, -1 bei Zeitüberschreitung.
+ */
+int32_t uart_write_buffered(const uint8_t *buffer, uint32_t length, uint32_t timeout_ms);
+
+/**
+ * @brief Wartet, bis der Software-Sendepuffer vollständig an die Hardware übergeben ist.
+ *
+ * @param timeout_ms Zeitlimit in Millisekunden.
+ * @return 0 bei Erfolg, -1 bei Zeitüberschreitung.
+ */
+int32_t uart_tx_drain(uint32_t timeout_ms);
+
+#endif
+
 /* Time Functions */
 /**
  * @brief Liest die Systemtaktfrequenz.
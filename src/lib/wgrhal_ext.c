@@ -8,6 +8,8 @@
  * - SPI-Kommunikation
  * - WS2812B LED-Steuerung
  * - PWM-basierte Tonerzeugung
+ * - DMA-Transfers
+ * - Stack-Auslastung
  * - Dynamischen Speicher (malloc)
  * - SSD1351 Display mit Terminal-Funktionen
  *
@@ -29,7 +31,7 @@ uint64_t mult_calc_64(uint32_t multiplicand, uint32_t multiplier)
     HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = multiplicand;
     HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = multiplier;
 
-    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET))
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
         ;
 
     uint64_t high = (uint64_t)HWREG32(MULT_BASE_ADDR + RESH_OFFSET);
@@ -43,7 +45,7 @@ uint32_t mult_calc(uint32_t multiplicand, uint32_t multiplier)
     HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = multiplicand;
     HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = multiplier;
 
-    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET))
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
         ;
 
     return HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
@@ -68,6 +70,25 @@ int32_t div_calc(uint32_t dividend, uint32_t divisor, div_result_t *result)
     return 0;
 }
 
+int32_t div_calc_signed(int32_t dividend, int32_t divisor, div_result_t *result)
+{
+    if (result == NULL || divisor == 0)
+    {
+        return -1;
+    }
+
+    HWREG32(DIV_BASE_ADDR + DIV_END_OFFSET) = (uint32_t)dividend;
+    HWREG32(DIV_BASE_ADDR + DIV_SSOR_OFFSET) = (uint32_t)divisor;
+
+    while (HWREG32(DIV_BASE_ADDR + DIV_INFO_OFFSET))
+        ;
+
+    result->quotient = HWREG32(DIV_BASE_ADDR + DIV_QUO_OFFSET);
+    result->remainder = HWREG32(DIV_BASE_ADDR + DIV_REM_OFFSET);
+
+    return 0;
+}
+
 uint32_t div_calc_quotient(uint32_t dividend, uint32_t divisor)
 {
     if (divisor == 0)
@@ -100,6 +121,229 @@ uint32_t div_calc_remainder(uint32_t dividend, uint32_t divisor)
     return HWREG32(DIV_BASE_ADDR + DIV_REM_OFFSET);
 }
 
+void mult_start(uint32_t multiplicand, uint32_t multiplier)
+{
+    HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = multiplicand;
+    HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = multiplier;
+}
+
+uint32_t mult_busy(void)
+{
+    return HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY;
+}
+
+uint32_t mult_get_latency(void)
+{
+    return (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) >> MULT_INFO_LAT_SHIFT) & 0xFF;
+}
+
+uint64_t mult_collect_64(void)
+{
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
+        ;
+
+    uint64_t high = (uint64_t)HWREG32(MULT_BASE_ADDR + RESH_OFFSET);
+    uint64_t low = (uint64_t)HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
+
+    return (high << 32) | low;
+}
+
+uint32_t mult_collect(void)
+{
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
+        ;
+
+    return HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
+}
+
+int32_t div_start(uint32_t dividend, uint32_t divisor)
+{
+    if (divisor == 0)
+    {
+        return -1;
+    }
+
+    HWREG32(DIV_BASE_ADDR + DIV_END_OFFSET) = dividend;
+    HWREG32(DIV_BASE_ADDR + DIV_SOR_OFFSET) = divisor;
+    return 0;
+}
+
+uint32_t div_busy(void)
+{
+    return HWREG32(DIV_BASE_ADDR + DIV_INFO_OFFSET);
+}
+
+uint32_t div_get_latency(void)
+{
+    return HWREG32(DIV_BASE_ADDR + DIV_LAT_OFFSET);
+}
+
+uint32_t div_predict_latency(uint32_t dividend, uint32_t divisor)
+{
+    if (divisor == 0 || dividend < divisor)
+    {
+        return 2;
+    }
+
+    uint32_t q_bits = __builtin_clz(divisor) - __builtin_clz(dividend) + 1;
+    return 2 + (q_bits + 1) / 2;
+}
+
+void div_collect(div_result_t *result)
+{
+    while (HWREG32(DIV_BASE_ADDR + DIV_INFO_OFFSET))
+        ;
+
+    result->quotient = HWREG32(DIV_BASE_ADDR + DIV_QUO_OFFSET);
+    result->remainder = HWREG32(DIV_BASE_ADDR + DIV_REM_OFFSET);
+}
+
+void mult_array(const uint32_t *a, const uint32_t *b, uint32_t *out, uint32_t n)
+{
+    uint32_t result;
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = a[0];
+    HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = b[0];
+
+    // Operanden für i laden und Ergebnis i-1 speichern, während i-1 bzw. i rechnet
+    for (uint32_t i = 1; i < n; i++)
+    {
+        uint32_t next_a = a[i];
+        uint32_t next_b = b[i];
+
+        while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
+            ;
+        result = HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
+
+        HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = next_a;
+        HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = next_b;
+        out[i - 1] = result;
+    }
+
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
+        ;
+    out[n - 1] = HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
+}
+
+void divmod_array(const uint32_t *dividend, const uint32_t *divisor, uint32_t *quotient,
+                  uint32_t *remainder, uint32_t n)
+{
+    uint32_t pending = 0;
+    uint32_t prev = 0;
+
+    // Wie mult_array, Divisor 0 wird ohne Hardware wie vom Divider beantwortet
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t next_end = dividend[i];
+        uint32_t next_sor = divisor[i];
+        uint32_t quo = 0;
+        uint32_t rem = 0;
+
+        if (pending)
+        {
+            while (HWREG32(DIV_BASE_ADDR + DIV_INFO_OFFSET))
+                ;
+            quo = HWREG32(DIV_BASE_ADDR + DIV_QUO_OFFSET);
+            rem = HWREG32(DIV_BASE_ADDR + DIV_REM_OFFSET);
+        }
+
+        if (next_sor != 0)
+        {
+            HWREG32(DIV_BASE_ADDR + DIV_END_OFFSET) = next_end;
+            HWREG32(DIV_BASE_ADDR + DIV_SOR_OFFSET) = next_sor;
+        }
+        else
+        {
+            quotient[i] = 0xFFFFFFFF;
+            if (remainder)
+            {
+                remainder[i] = next_end;
+            }
+        }
+
+        if (pending)
+        {
+            quotient[prev] = quo;
+            if (remainder)
+            {
+                remainder[prev] = rem;
+            }
+        }
+
+        pending = (next_sor != 0);
+        prev = i;
+    }
+
+    if (pending)
+    {
+        div_result_t result;
+        div_collect(&result);
+        quotient[prev] = result.quotient;
+        if (remainder)
+        {
+            remainder[prev] = result.remainder;
+        }
+    }
+}
+
+int32_t udiv_const_init(udiv_const_t *d, uint32_t divisor)
+{
+    uint32_t l = 0;
+    uint32_t rem;
+    uint32_t q = 0;
+
+    if (d == NULL || divisor == 0)
+    {
+        return -1;
+    }
+
+    while (l < 32 && (1U << l) < divisor)
+    {
+        l++;
+    }
+
+    // floor(2^32 * (2^l - d) / d) per Schiebe-Subtrahier-Division, (2^l - d) < d
+    rem = (l == 32) ? 0U - divisor : (1U << l) - divisor;
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        uint32_t carry = rem >> 31;
+        rem <<= 1;
+        q <<= 1;
+        if (carry || rem >= divisor)
+        {
+            rem -= divisor;
+            q |= 1;
+        }
+    }
+
+    d->magic = q + 1;
+    d->divisor = divisor;
+    d->shift1 = (l > 0) ? 1 : 0;
+    d->shift2 = (l > 0) ? (uint8_t)(l - 1) : 0;
+    return 0;
+}
+
+uint32_t udiv_const_div(uint32_t n, const udiv_const_t *d)
+{
+#ifdef UDIV_HW_MULT
+    HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = n;
+    HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = d->magic;
+
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY)
+        ;
+
+    uint32_t t = HWREG32(MULT_BASE_ADDR + RESH_OFFSET);
+    return (t + ((n - t) >> d->shift1)) >> d->shift2;
+#else
+    return n / d->divisor;
+#endif
+}
+
 // ----------------------- WGR-V -----------------------
 //
 //                    SPI Funktionen
@@ -160,6 +404,40 @@ void spi_set_clock_divider(uint32_t divider)
     spi_set_clock_offset(offset);
 }
 
+void spi_set_frame_width(uint32_t bits)
+{
+    uint32_t frame = SPI_FRAME_8;
+
+    if (bits == 16)
+    {
+        frame = SPI_FRAME_16;
+    }
+    else if (bits == 32)
+    {
+        frame = SPI_FRAME_32;
+    }
+
+    uint32_t reg = HWREG32(SPI_BASE_ADDR + SPI_CTRL_OFFSET);
+    reg &= ~(3U << SPI_CTRL_FRAME_SHIFT);
+    reg |= frame << SPI_CTRL_FRAME_SHIFT;
+    HWREG32(SPI_BASE_ADDR + SPI_CTRL_OFFSET) = reg;
+}
+
+uint32_t spi_get_frame_width(void)
+{
+    uint32_t frame = (HWREG32(SPI_BASE_ADDR + SPI_CTRL_OFFSET) >> SPI_CTRL_FRAME_SHIFT) & 3U;
+
+    if (frame == SPI_FRAME_16)
+    {
+        return 16;
+    }
+    if (frame == SPI_FRAME_32)
+    {
+        return 32;
+    }
+    return 8;
+}
+
 uint32_t spi_get_status(void)
 {
     return HWREG32(SPI_BASE_ADDR + SPI_STATUS_OFFSET);
@@ -200,6 +478,16 @@ uint32_t spi_tx_empty(void)
     return ((spi_get_status() >> 0) & (uint32_t)1);
 }
 
+uint32_t spi_tx_free(void)
+{
+    return SPI_TX_FIFO_DEPTH - HWREG32(SPI_BASE_ADDR + SPI_TX_LEVEL_OFFSET);
+}
+
+uint32_t spi_rx_avail(void)
+{
+    return HWREG32(SPI_BASE_ADDR + SPI_RX_LEVEL_OFFSET);
+}
+
 int32_t spi_wait_rx_data(uint32_t timeout_ms)
 {
     uint32_t start_time = millis();
@@ -260,12 +548,34 @@ int32_t spi_write_buffer(const uint8_t *buf, uint32_t length, uint32_t timeout_m
     {
         return -1;
     }
-    for (uint32_t i = 0; i < length; i++)
+
+    uint32_t i = 0;
+    uint32_t start_time = 0;
+    uint32_t stalled = 0;
+
+    while (i < length)
     {
-        int32_t ret = spi_write_byte(buf[i], timeout_ms);
-        if (ret != 0)
+        uint32_t room = spi_tx_free();
+
+        if (room == 0)
         {
-            return ret;
+            if (!stalled)
+            {
+                start_time = millis();
+                stalled = 1;
+            }
+            else if ((millis() - start_time) >= timeout_ms)
+            {
+                return -1;
+            }
+            continue;
+        }
+
+        stalled = 0;
+        while (room && i < length)
+        {
+            HWREG32(SPI_BASE_ADDR + SPI_TX_OFFSET) = (uint32_t)buf[i++];
+            room--;
         }
     }
     return 0;
@@ -273,31 +583,144 @@ int32_t spi_write_buffer(const uint8_t *buf, uint32_t length, uint32_t timeout_m
 
 int32_t spi_write_uint32(uint32_t value, uint32_t timeout_ms)
 {
-    uint8_t buf[4];
-    buf[0] = (uint8_t)((value >> 24) & 0xFF);
-    buf[1] = (uint8_t)((value >> 16) & 0xFF);
-    buf[2] = (uint8_t)((value >> 8) & 0xFF);
-    buf[3] = (uint8_t)(value & 0xFF);
-    return spi_write_buffer(buf, 4, timeout_ms);
+    return spi_write_words(&value, 1, 32, timeout_ms);
 }
 
-int32_t spi_read_buffer(uint8_t *buf, uint32_t length, uint32_t timeout_ms)
+int32_t spi_write_words(const uint32_t *buf, uint32_t count, uint32_t bits, uint32_t timeout_ms)
 {
     if (buf == 0)
     {
         return -1;
     }
-    for (uint32_t i = 0; i < length; i++)
+
+    uint32_t ctrl = HWREG32(SPI_BASE_ADDR + SPI_CTRL_OFFSET);
+    uint32_t i = 0;
+    uint32_t start_time = 0;
+    uint32_t stalled = 0;
+    int32_t ret = 0;
+
+    spi_set_frame_width(bits);
+    bits = spi_get_frame_width();
+
+    /* Bei 8 Bit wäre Bit 8 das Lese-Flag */
+    uint32_t mask = (bits == 32) ? 0xFFFFFFFFU : ((1U << bits) - 1U);
+
+    while (i < count)
     {
-        int32_t ret = spi_read_byte(&buf[i], timeout_ms);
-        if (ret < 0)
+        uint32_t room = spi_tx_free();
+
+        if (room == 0)
         {
-            return ret;
+            if (!stalled)
+            {
+                start_time = millis();
+                stalled = 1;
+            }
+            else if ((millis() - start_time) >= timeout_ms)
+            {
+                ret = -1;
+                break;
+            }
+            continue;
+        }
+
+        stalled = 0;
+        while (room && i < count)
+        {
+            HWREG32(SPI_BASE_ADDR + SPI_TX_OFFSET) = buf[i++] & mask;
+            room--;
+        }
+    }
+
+    HWREG32(SPI_BASE_ADDR + SPI_CTRL_OFFSET) = ctrl;
+    return ret;
+}
+
+int32_t spi_transfer_buffer(const uint8_t *tx, uint8_t *rx, uint32_t length, uint32_t timeout_ms)
+{
+    if (rx == 0)
+    {
+        return spi_write_buffer(tx, length, timeout_ms);
+    }
+
+    uint32_t issued = 0;
+    uint32_t received = 0;
+    uint32_t start_time = 0;
+    uint32_t stalled = 0;
+
+    /* Reste eines früheren, abgebrochenen Transfers verwerfen */
+    while (!spi_rx_empty())
+    {
+        (void)HWREG32(SPI_BASE_ADDR + SPI_RX_OFFSET);
+    }
+
+    while (received < length)
+    {
+        uint32_t avail = spi_rx_avail();
+
+        /* Nur Antworten auf eigene Token abholen, nie über rx hinaus */
+        if (avail > issued - received)
+        {
+            avail = issued - received;
+        }
+        uint32_t progress = avail;
+
+        while (avail && received < length)
+        {
+            rx[received++] = (uint8_t)(HWREG32(SPI_BASE_ADDR + SPI_RX_OFFSET) & 0xFF);
+            avail--;
+        }
+
+        /* Nie mehr Token ausstehend als in den RX-FIFO passen */
+        uint32_t tokens = SPI_RX_FIFO_DEPTH - (issued - received);
+        if (tokens > length - issued)
+        {
+            tokens = length - issued;
+        }
+        if (tokens)
+        {
+            uint32_t room = spi_tx_free();
+            if (tokens > room)
+            {
+                tokens = room;
+            }
+        }
+
+        progress += tokens;
+        while (tokens)
+        {
+            uint32_t data = tx ? (uint32_t)tx[issued] : SPI_READ_DUMMY;
+            HWREG32(SPI_BASE_ADDR + SPI_TX_OFFSET) = SPI_READ_FLAG | data;
+            issued++;
+            tokens--;
+        }
+
+        if (progress)
+        {
+            stalled = 0;
+        }
+        else if (!stalled)
+        {
+            start_time = millis();
+            stalled = 1;
+        }
+        else if ((millis() - start_time) >= timeout_ms)
+        {
+            return -1;
         }
     }
     return 0;
 }
 
+int32_t spi_read_buffer(uint8_t *buf, uint32_t length, uint32_t timeout_ms)
+{
+    if (buf == 0)
+    {
+        return -1;
+    }
+    return spi_transfer_buffer(0, buf, length, timeout_ms);
+}
+
 // ----------------------- WGR-V -----------------------
 //
 //                  WS2812B Funktionen
@@ -368,27 +791,104 @@ void ws2812_clear(void)
     }
 }
 
-#ifdef PWM_NOTES
-
 // ----------------------- WGR-V -----------------------
 //
-//       Frequenzen und Noten per PWM abspielen
+//                    DMA Funktionen
 //
 //------------------------------------------------------
 
-#ifdef PWM_NOTES
-#ifndef MALLOC
-#error "Requires malloc. Define MALLOC to use PWM_NOTES."
-#endif
-#endif
+void dma_start(const volatile void *src, volatile void *dst, uint32_t count, uint32_t ctrl)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    HWREG32(DMA_BASE_ADDR + DMA_SRC_OFFSET) = (uint32_t)src;
+    HWREG32(DMA_BASE_ADDR + DMA_DST_OFFSET) = (uint32_t)dst;
+    HWREG32(DMA_BASE_ADDR + DMA_LEN_OFFSET) = count;
+    HWREG32(DMA_BASE_ADDR + DMA_CTRL_OFFSET) = ctrl | DMA_CTRL_START;
+}
 
-static uint32_t *note_buffer = 0;
+uint32_t dma_busy(void)
+{
+    return HWREG32(DMA_BASE_ADDR + DMA_STATUS_OFFSET) & DMA_STATUS_BUSY;
+}
 
-const uint8_t note_freq_halfbase[12] = {
-    131,
-    139,
-    147,
-    156,
+int32_t dma_wait(uint32_t timeout_ms)
+{
+    uint32_t start_time = millis();
+    uint32_t remaining = HWREG32(DMA_BASE_ADDR + DMA_LEN_OFFSET);
+
+    while (dma_busy())
+    {
+#ifdef UART_TX_BUFFER
+        uart_flush_pending();
+#endif
+        uint32_t now_remaining = HWREG32(DMA_BASE_ADDR + DMA_LEN_OFFSET);
+        if (now_remaining != remaining)
+        {
+            remaining = now_remaining;
+            start_time = millis();
+        }
+        else if ((millis() - start_time) >= timeout_ms)
+        {
+            dma_abort();
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void dma_abort(void)
+{
+    uint32_t reg = HWREG32(DMA_BASE_ADDR + DMA_CTRL_OFFSET);
+    HWREG32(DMA_BASE_ADDR + DMA_CTRL_OFFSET) = reg & ~DMA_CTRL_START;
+}
+
+// ----------------------- WGR-V -----------------------
+//
+//                    Stack Funktionen
+//
+//------------------------------------------------------
+
+uint32_t stack_high_water(void)
+{
+    const uint32_t *p = (const uint32_t *)&_sstack;
+    const uint32_t *end = (const uint32_t *)&_estack;
+
+    while (p < end && *p == STACK_CANARY)
+    {
+        p++;
+    }
+    return (uint32_t)((const char *)end - (const char *)p);
+}
+
+uint32_t stack_size(void)
+{
+    return (uint32_t)(&_estack - &_sstack);
+}
+
+#ifdef PWM_NOTES
+
+// ----------------------- WGR-V -----------------------
+//
+//       Frequenzen und Noten per PWM abspielen
+//
+//------------------------------------------------------
+
+#ifdef PWM_NOTES
+#ifndef MALLOC
+#error "Requires malloc. Define MALLOC to use PWM_NOTES."
+#endif
+#endif
+
+static uint32_t *note_buffer = 0;
+
+const uint8_t note_freq_halfbase[12] = {
+    131,
+    139,
+    147,
+    156,
     165,
     175,
     185,
@@ -398,6 +898,12 @@ const uint8_t note_freq_halfbase[12] = {
     233,
     247};
 
+// Kehrwerte zu note_freq_halfbase, vom Compiler vorberechnet
+static const udiv_const_t note_freq_div[12] = {
+    UDIV_CONST(131), UDIV_CONST(139), UDIV_CONST(147), UDIV_CONST(156),
+    UDIV_CONST(165), UDIV_CONST(175), UDIV_CONST(185), UDIV_CONST(196),
+    UDIV_CONST(208), UDIV_CONST(220), UDIV_CONST(233), UDIV_CONST(247)};
+
 int pwm_precompute_notes(void)
 {
     uint32_t sys_clk = get_sys_clk();
@@ -414,7 +920,7 @@ int pwm_precompute_notes(void)
 
     for (int i = 0; i < 12; i++)
     {
-        note_buffer[i] = (uint32_t)(sys_clk / note_freq_halfbase[i]);
+        note_buffer[i] = udiv_const_div(sys_clk, &note_freq_div[i]);
         debug_write(note_buffer[i]);
     }
 
@@ -456,61 +962,516 @@ void pwm_play_note(note_t note, uint32_t octave)
     pwm_set_mode(1);
     pwm_set_50_percent_mode(1);
 
-    pwm_set_period(period);
-    pwm_set_pre_counter(prescaler);
+    pwm_set_period(period);
+    pwm_set_pre_counter(prescaler);
+}
+
+void pwm_free_note_buffer(void)
+{
+    if (note_buffer)
+    {
+        free(note_buffer);
+        note_buffer = 0;
+    }
+}
+
+#endif
+
+#ifdef MALLOC
+
+// ----------------------- WGR-V -----------------------
+//
+//                        malloc
+//
+//------------------------------------------------------
+
+typedef int ptrdiff_t;
+
+static void heap_release(void *ap);
+static uint32_t block_usable_size(void *ptr);
+
+int errno;
+#define ENOMEM 12
+
+extern char _heap_start;
+extern char _heap_end;
+
+static char *heap_ptr = &_heap_start;
+
+static uint32_t heap_used = 0;
+static uint32_t heap_peak = 0;
+static uint32_t heap_alloc_count = 0;
+static uint32_t heap_free_count = 0;
+static uint32_t heap_fail_count = 0;
+
+#ifdef HEAP_TRACE
+/**
+ * @brief Gibt ein Heap-Ereignis als zwei Wörter über debug_write aus.
+ *
+ * Erstes Wort: Ereignistyp in Bit 31:24, Größe in Bit 23:0.
+ * Zweites Wort: Adresse des Blocks bzw. neues Heap-Ende bei sbrk.
+ */
+static void heap_trace(uint32_t type, uint32_t size, void *ptr)
+{
+    debug_write((type << 24) | (size & 0x00FFFFFF));
+    debug_write((uint32_t)ptr);
+}
+#define HEAP_TRACE_EVENT(type, size, ptr) heap_trace((type), (size), (ptr))
+#else
+#define HEAP_TRACE_EVENT(type, size, ptr)
+#endif
+
+/**
+ * @brief Erweitert den Heap um eine angegebene Anzahl von Bytes.
+ *
+ * Diese Funktion wird intern von malloc verwendet, um den verfügbaren Heap-Speicher zu erweitern.
+ *
+ * @param incr Anzahl der Bytes, um die der Heap erweitert werden soll.
+ * @return Zeiger auf den vorherigen Heap-Ende oder (void *)-1 bei Fehler, wenn nicht genügend Speicher vorhanden ist.
+ */
+static void *sbrk(int32_t incr)
+{
+    char *prev = heap_ptr;
+    if (heap_ptr + incr > &_heap_end)
+    {
+        errno = ENOMEM;
+        return (void *)-1;
+    }
+    heap_ptr += incr;
+    HEAP_TRACE_EVENT(HEAP_TRACE_SBRK, (uint32_t)incr, heap_ptr);
+    return prev;
+}
+
+uint32_t heap_free_space(void)
+{
+    uint32_t free_space = (uint32_t)(&_heap_end - heap_ptr);
+    return free_space;
+}
+
+#ifdef MALLOC_TLSF
+
+/*
+ * TLSF (Two-Level Segregated Fit)
+ *
+ * Freie Blöcke werden in Größenklassen einsortiert: Die erste Stufe ist die
+ * Zweierpotenz der Größe, die zweite Stufe teilt jede Zweierpotenz linear in
+ * TLSF_SL_COUNT Unterklassen. Zwei Bitmaps zeigen, welche Listen belegt sind,
+ * sodass malloc und free ohne Suche über die Freiliste auskommen. Jeder Block
+ * trägt einen Header mit Größe und Flags, ein freier Vorgänger wird über
+ * prev_phys (Boundary Tag) gefunden und beim Freigeben sofort verschmolzen.
+ */
+
+#ifndef TLSF_SL_INDEX_COUNT_LOG2
+#define TLSF_SL_INDEX_COUNT_LOG2 3
+#endif
+#ifndef TLSF_FL_INDEX_MAX
+#define TLSF_FL_INDEX_MAX 16
+#endif
+
+#define TLSF_ALIGN_SIZE_LOG2 2
+#define TLSF_ALIGN_SIZE (1U << TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_SL_COUNT (1U << TLSF_SL_INDEX_COUNT_LOG2)
+#define TLSF_FL_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_FL_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL_BLOCK_SIZE (1U << TLSF_FL_SHIFT)
+
+#define TLSF_BLOCK_FREE (1U << 0)
+#define TLSF_PREV_FREE (1U << 1)
+#define TLSF_SIZE_MASK (~(TLSF_BLOCK_FREE | TLSF_PREV_FREE))
+
+#define TLSF_GROW_MIN 1024
+
+uint32_t __clzsi2(uint32_t x);
+uint32_t __ffssi2(uint32_t x);
+
+typedef struct tlsf_block
+{
+    struct tlsf_block *prev_phys; // Nur gültig, wenn TLSF_PREV_FREE gesetzt ist
+    uint32_t size;                // Nutzgröße in Byte | Flags
+    struct tlsf_block *next_free; // Nur in freien Blöcken
+    struct tlsf_block *prev_free; // Nur in freien Blöcken
+} tlsf_block_t;
+
+#define TLSF_HEADER_SIZE (2 * sizeof(uint32_t))
+#define TLSF_MIN_SIZE (sizeof(tlsf_block_t) - TLSF_HEADER_SIZE)
+
+static uint32_t tlsf_fl_bitmap = 0;
+static uint32_t tlsf_sl_bitmap[TLSF_FL_COUNT];
+static tlsf_block_t *tlsf_blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+static char *tlsf_pool_end = 0;
+
+/**
+ * @brief Index des höchsten gesetzten Bits (x != 0).
+ */
+static inline uint32_t tlsf_fls(uint32_t x)
+{
+    return 31 - __clzsi2(x);
+}
+
+/**
+ * @brief Index des niedrigsten gesetzten Bits (x != 0).
+ */
+static inline uint32_t tlsf_ffs(uint32_t x)
+{
+    return __ffssi2(x & (0U - x)) - 1;
+}
+
+static inline uint32_t tlsf_block_size(const tlsf_block_t *block)
+{
+    return block->size & TLSF_SIZE_MASK;
+}
+
+static inline tlsf_block_t *tlsf_block_next(const tlsf_block_t *block)
+{
+    return (tlsf_block_t *)((char *)block + TLSF_HEADER_SIZE + tlsf_block_size(block));
+}
+
+static inline void *tlsf_block_to_ptr(tlsf_block_t *block)
+{
+    return (char *)block + TLSF_HEADER_SIZE;
+}
+
+static inline tlsf_block_t *tlsf_ptr_to_block(void *ptr)
+{
+    return (tlsf_block_t *)((char *)ptr - TLSF_HEADER_SIZE);
+}
+
+/**
+ * @brief Ermittelt die Größenklasse, in die ein Block der Größe size gehört.
+ */
+static void tlsf_mapping_insert(uint32_t size, uint32_t *fli, uint32_t *sli)
+{
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        *fli = 0;
+        *sli = size >> TLSF_ALIGN_SIZE_LOG2;
+    }
+    else
+    {
+        uint32_t fl = tlsf_fls(size);
+        *sli = (size >> (fl - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_COUNT;
+        *fli = fl - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+/**
+ * @brief Ermittelt die kleinste Größenklasse, deren Blöcke alle mindestens size Byte groß sind.
+ */
+static void tlsf_mapping_search(uint32_t size, uint32_t *fli, uint32_t *sli)
+{
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+    {
+        size += (1U << (tlsf_fls(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    tlsf_mapping_insert(size, fli, sli);
+}
+
+static void tlsf_remove_free(tlsf_block_t *block)
+{
+    uint32_t fl, sl;
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+
+    if (block->next_free)
+        block->next_free->prev_free = block->prev_free;
+    if (block->prev_free)
+        block->prev_free->next_free = block->next_free;
+    else
+    {
+        tlsf_blocks[fl][sl] = block->next_free;
+        if (!block->next_free)
+        {
+            tlsf_sl_bitmap[fl] &= ~(1U << sl);
+            if (!tlsf_sl_bitmap[fl])
+                tlsf_fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+static void tlsf_insert_free(tlsf_block_t *block)
+{
+    uint32_t fl, sl;
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+
+    tlsf_block_t *head = tlsf_blocks[fl][sl];
+    block->next_free = head;
+    block->prev_free = 0;
+    if (head)
+        head->prev_free = block;
+    tlsf_blocks[fl][sl] = block;
+    tlsf_fl_bitmap |= 1U << fl;
+    tlsf_sl_bitmap[fl] |= 1U << sl;
+}
+
+/**
+ * @brief Markiert einen Block als frei und setzt den Boundary Tag im Nachfolger.
+ */
+static void tlsf_mark_free(tlsf_block_t *block)
+{
+    tlsf_block_t *next = tlsf_block_next(block);
+    block->size |= TLSF_BLOCK_FREE;
+    next->prev_phys = block;
+    next->size |= TLSF_PREV_FREE;
+}
+
+static void tlsf_mark_used(tlsf_block_t *block)
+{
+    tlsf_block_t *next = tlsf_block_next(block);
+    block->size &= ~TLSF_BLOCK_FREE;
+    next->size &= ~TLSF_PREV_FREE;
+}
+
+/**
+ * @brief Verschmilzt einen freien Block mit freien physischen Nachbarn.
+ *
+ * Der Block selbst darf in keiner Freiliste stehen.
+ *
+ * @return Zeiger auf den verschmolzenen Block.
+ */
+static tlsf_block_t *tlsf_merge(tlsf_block_t *block)
+{
+    if (block->size & TLSF_PREV_FREE)
+    {
+        tlsf_block_t *prev = block->prev_phys;
+        tlsf_remove_free(prev);
+        prev->size += TLSF_HEADER_SIZE + tlsf_block_size(block);
+        block = prev;
+    }
+
+    tlsf_block_t *next = tlsf_block_next(block);
+    if (next->size & TLSF_BLOCK_FREE)
+    {
+        tlsf_remove_free(next);
+        block->size += TLSF_HEADER_SIZE + tlsf_block_size(next);
+    }
+
+    tlsf_mark_free(block);
+    return block;
+}
+
+/**
+ * @brief Teilt einen Block auf size Byte und gibt den Rest in die Freiliste.
+ */
+static void tlsf_split(tlsf_block_t *block, uint32_t size)
+{
+    uint32_t block_size = tlsf_block_size(block);
+    if (block_size < size + sizeof(tlsf_block_t))
+    {
+        return;
+    }
+
+    tlsf_block_t *rest = (tlsf_block_t *)((char *)block + TLSF_HEADER_SIZE + size);
+    rest->size = block_size - size - TLSF_HEADER_SIZE;
+    block->size = size | (block->size & ~TLSF_SIZE_MASK);
+    tlsf_mark_free(rest);
+    tlsf_insert_free(tlsf_merge(rest));
+}
+
+/**
+ * @brief Sucht einen freien Block aus der Klasse (fl, sl) oder einer größeren.
+ */
+static tlsf_block_t *tlsf_search(uint32_t fl, uint32_t sl)
+{
+    uint32_t sl_map = tlsf_sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map)
+    {
+        uint32_t fl_map = tlsf_fl_bitmap & (~0U << (fl + 1));
+        if (!fl_map)
+        {
+            return 0;
+        }
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf_sl_bitmap[fl];
+    }
+    return tlsf_blocks[fl][tlsf_ffs(sl_map)];
+}
+
+/**
+ * @brief Erweitert den TLSF-Pool über sbrk um mindestens size Byte Nutzgröße.
+ *
+ * Schließt der neue Bereich direkt an den bisherigen Pool an, wird der alte
+ * Endmarker zum Header des neuen Blocks und mit einem freien Vorgänger
+ * verschmolzen. Am Ende des Pools steht immer ein belegter Block der Größe 0.
+ *
+ * @return 0 bei Erfolg, -1 wenn der Heap erschöpft ist.
+ */
+static int32_t tlsf_grow(uint32_t size)
+{
+    uint32_t incr = size + 2 * TLSF_HEADER_SIZE;
+    if (incr < TLSF_GROW_MIN)
+    {
+        incr = TLSF_GROW_MIN;
+    }
+
+    char *cp = sbrk(incr);
+    if (cp == (char *)-1)
+    {
+        incr = size + 2 * TLSF_HEADER_SIZE;
+        cp = sbrk(incr);
+        if (cp == (char *)-1)
+        {
+            return -1;
+        }
+    }
+
+    tlsf_block_t *block;
+    if (cp == tlsf_pool_end)
+    {
+        block = (tlsf_block_t *)(cp - TLSF_HEADER_SIZE);
+        block->size = (incr - TLSF_HEADER_SIZE) | (block->size & TLSF_PREV_FREE);
+    }
+    else
+    {
+        block = (tlsf_block_t *)cp;
+        block->size = incr - 2 * TLSF_HEADER_SIZE;
+    }
+
+    tlsf_pool_end = cp + incr;
+    tlsf_block_t *sentinel = tlsf_block_next(block);
+    sentinel->size = 0;
+
+    tlsf_mark_free(block);
+    tlsf_insert_free(tlsf_merge(block));
+    return 0;
+}
+
+/**
+ * @brief Rundet eine angeforderte Größe auf eine gültige Blockgröße.
+ *
+ * @return Blockgröße in Byte oder 0, wenn die Anforderung zu groß ist.
+ */
+static uint32_t tlsf_adjust_size(uint32_t nbytes)
+{
+    if (nbytes > (1U << TLSF_FL_INDEX_MAX) - sizeof(tlsf_block_t))
+    {
+        return 0;
+    }
+
+    uint32_t size = (nbytes + TLSF_ALIGN_SIZE - 1) & ~(TLSF_ALIGN_SIZE - 1);
+    if (size < TLSF_MIN_SIZE)
+    {
+        size = TLSF_MIN_SIZE;
+    }
+    return size;
+}
+
+static void *heap_alloc(uint32_t nbytes)
+{
+    uint32_t size = tlsf_adjust_size(nbytes);
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    uint32_t fl, sl;
+    tlsf_mapping_search(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT)
+    {
+        return 0;
+    }
+
+    tlsf_block_t *block = tlsf_search(fl, sl);
+    if (!block)
+    {
+        // Gerundete Größe anfordern, damit der neue Block in Klasse (fl, sl) passt
+        uint32_t rounded = size;
+        if (size >= TLSF_SMALL_BLOCK_SIZE)
+        {
+            rounded += (1U << (tlsf_fls(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+            rounded &= ~(TLSF_ALIGN_SIZE - 1);
+        }
+        if (tlsf_grow(rounded) < 0)
+        {
+            return 0;
+        }
+        block = tlsf_search(fl, sl);
+        if (!block)
+        {
+            return 0;
+        }
+    }
+
+    tlsf_remove_free(block);
+    tlsf_mark_used(block);
+    tlsf_split(block, size);
+    return tlsf_block_to_ptr(block);
+}
+
+static void heap_release(void *ap)
+{
+    tlsf_block_t *block = tlsf_ptr_to_block(ap);
+    tlsf_insert_free(tlsf_merge(block));
+}
+
+/**
+ * @brief Liefert die nutzbare Größe eines allokierten Blocks.
+ *
+ * @param ptr Zeiger auf den Speicherblock.
+ * @return Nutzbare Größe in Byte.
+ */
+static uint32_t block_usable_size(void *ptr)
+{
+    return tlsf_block_size(tlsf_ptr_to_block(ptr));
 }
 
-void pwm_free_note_buffer(void)
+/**
+ * @brief Durchläuft alle Freilisten und trägt freie Blöcke in die Statistik ein.
+ */
+static void heap_walk_free(heap_stats_t *stats)
 {
-    if (note_buffer)
+    for (uint32_t fl = 0; fl < TLSF_FL_COUNT; fl++)
     {
-        free(note_buffer);
-        note_buffer = 0;
+        for (uint32_t sl = 0; sl < TLSF_SL_COUNT; sl++)
+        {
+            for (tlsf_block_t *block = tlsf_blocks[fl][sl]; block; block = block->next_free)
+            {
+                uint32_t bytes = tlsf_block_size(block);
+                stats->free_bytes += bytes;
+                stats->free_blocks++;
+                if (bytes > stats->largest_free)
+                    stats->largest_free = bytes;
+            }
+        }
     }
 }
 
-#endif
-
-#ifdef MALLOC
-
-// ----------------------- WGR-V -----------------------
-//
-//                        malloc
-//
-//------------------------------------------------------
-
-typedef int ptrdiff_t;
-
-void free(void *ap);
-
-int errno;
-#define ENOMEM 12
-
-extern char _heap_start;
-extern char _heap_end;
-
-static char *heap_ptr = &_heap_start;
-
 /**
- * @brief Erweitert den Heap um eine angegebene Anzahl von Bytes.
+ * @brief Ändert die Größe eines allokierten Blocks ohne ihn zu verschieben.
  *
- * Diese Funktion wird intern von malloc verwendet, um den verfügbaren Heap-Speicher zu erweitern.
+ * Verkleinern gibt den Rest frei, Vergrößern übernimmt einen freien
+ * physischen Nachfolger.
  *
- * @param incr Anzahl der Bytes, um die der Heap erweitert werden soll.
- * @return Zeiger auf den vorherigen Heap-Ende oder (void *)-1 bei Fehler, wenn nicht genügend Speicher vorhanden ist.
+ * @param ptr Zeiger auf den Speicherblock.
+ * @param nbytes Neue Größe in Byte.
+ * @return 0 bei Erfolg, -1 wenn der Block verschoben werden muss.
  */
-static void *sbrk(int32_t incr)
+static int32_t block_resize(void *ptr, uint32_t nbytes)
 {
-    char *prev = heap_ptr;
-    if (heap_ptr + incr > &_heap_end)
+    uint32_t size = tlsf_adjust_size(nbytes);
+    if (size == 0)
     {
-        errno = ENOMEM;
-        return (void *)-1;
+        return -1;
     }
-    heap_ptr += incr;
-    return prev;
+
+    tlsf_block_t *block = tlsf_ptr_to_block(ptr);
+    uint32_t cur = tlsf_block_size(block);
+    if (size > cur)
+    {
+        tlsf_block_t *next = tlsf_block_next(block);
+        if (!(next->size & TLSF_BLOCK_FREE) ||
+            cur + TLSF_HEADER_SIZE + tlsf_block_size(next) < size)
+        {
+            return -1;
+        }
+        tlsf_remove_free(next);
+        block->size += TLSF_HEADER_SIZE + tlsf_block_size(next);
+        tlsf_mark_used(block);
+    }
+    tlsf_split(block, size);
+    return 0;
 }
 
+#else
+
 typedef long Align;
 
 union header
@@ -530,12 +1491,6 @@ static Header *freep = 0;
 
 #define NALLOC 1024
 
-uint32_t heap_free_space(void)
-{
-    uint32_t free_space = (uint32_t)(&_heap_end - heap_ptr);
-    return free_space;
-}
-
 /**
  * @brief Fordert zusätzlichen Speicher im Heap an.
  *
@@ -556,13 +1511,17 @@ static Header *morecore(uint32_t nu)
     }
     Header *up = (Header *)cp;
     up->s.size = nu;
-    free((void *)(up + 1));
+    heap_release((void *)(up + 1));
     return freep;
 }
 
-void *malloc(uint32_t nbytes)
+static void *heap_alloc(uint32_t nbytes)
 {
     Header *p, *prevp;
+    if (nbytes > (uint32_t)(&_heap_end - &_heap_start))
+    {
+        return 0;
+    }
     uint32_t nunits = (nbytes + sizeof(Header) - 1) / sizeof(Header) + 1;
     if ((prevp = freep) == 0)
     {
@@ -595,12 +1554,8 @@ void *malloc(uint32_t nbytes)
     }
 }
 
-void free(void *ap)
+static void heap_release(void *ap)
 {
-    if (!ap)
-    {
-        return;
-    }
     Header *bp = (Header *)ap - 1;
     Header *p;
 
@@ -632,6 +1587,127 @@ void free(void *ap)
     freep = p;
 }
 
+/**
+ * @brief Liefert die nutzbare Größe eines allokierten Blocks.
+ *
+ * @param ptr Zeiger auf den Speicherblock.
+ * @return Nutzbare Größe in Byte.
+ */
+static uint32_t block_usable_size(void *ptr)
+{
+    Header *hdr = (Header *)ptr - 1;
+    return (hdr->s.size - 1) * sizeof(Header);
+}
+
+/**
+ * @brief Ändert die Größe eines allokierten Blocks ohne ihn zu verschieben.
+ *
+ * Verkleinern gibt den Rest frei, Vergrößern übernimmt einen direkt
+ * folgenden freien Block aus der (adressgeordneten) Freiliste.
+ *
+ * @param ptr Zeiger auf den Speicherblock.
+ * @param nbytes Neue Größe in Byte.
+ * @return 0 bei Erfolg, -1 wenn der Block verschoben werden muss.
+ */
+static int32_t block_resize(void *ptr, uint32_t nbytes)
+{
+    if (nbytes > (uint32_t)(&_heap_end - &_heap_start))
+    {
+        return -1;
+    }
+    Header *bp = (Header *)ptr - 1;
+    uint32_t nunits = (nbytes + sizeof(Header) - 1) / sizeof(Header) + 1;
+
+    if (nunits > bp->s.size)
+    {
+        Header *p = freep;
+        do
+        {
+            if (p->s.next == bp + bp->s.size)
+            {
+                break;
+            }
+            p = p->s.next;
+        } while (p != freep);
+
+        Header *q = p->s.next;
+        if (q != bp + bp->s.size || bp->s.size + q->s.size < nunits)
+        {
+            return -1;
+        }
+        p->s.next = q->s.next;
+        bp->s.size += q->s.size;
+        freep = p;
+    }
+
+    if (bp->s.size > nunits)
+    {
+        Header *rest = bp + nunits;
+        rest->s.size = bp->s.size - nunits;
+        bp->s.size = nunits;
+        heap_release((void *)(rest + 1));
+    }
+    return 0;
+}
+
+/**
+ * @brief Durchläuft die Freiliste und trägt freie Blöcke in die Statistik ein.
+ */
+static void heap_walk_free(heap_stats_t *stats)
+{
+    if (freep == 0)
+    {
+        return;
+    }
+    Header *p = freep;
+    do
+    {
+        if (p->s.size > 1)
+        {
+            uint32_t bytes = (p->s.size - 1) * sizeof(Header);
+            stats->free_bytes += bytes;
+            stats->free_blocks++;
+            if (bytes > stats->largest_free)
+                stats->largest_free = bytes;
+        }
+        p = p->s.next;
+    } while (p != freep);
+}
+
+#endif
+
+void *malloc(uint32_t nbytes)
+{
+    void *ptr = heap_alloc(nbytes);
+    if (!ptr)
+    {
+        heap_fail_count++;
+        HEAP_TRACE_EVENT(HEAP_TRACE_FAIL, nbytes, 0);
+        return 0;
+    }
+    heap_alloc_count++;
+    heap_used += block_usable_size(ptr);
+    if (heap_used > heap_peak)
+    {
+        heap_peak = heap_used;
+    }
+    HEAP_TRACE_EVENT(HEAP_TRACE_MALLOC, nbytes, ptr);
+    return ptr;
+}
+
+void free(void *ap)
+{
+    if (!ap)
+    {
+        return;
+    }
+    uint32_t size = block_usable_size(ap);
+    heap_free_count++;
+    heap_used -= size;
+    HEAP_TRACE_EVENT(HEAP_TRACE_FREE, size, ap);
+    heap_release(ap);
+}
+
 void *realloc(void *ptr, uint32_t size)
 {
     if (!ptr)
@@ -642,36 +1718,201 @@ void *realloc(void *ptr, uint32_t size)
         return 0;
     }
 
-    Header *old_hdr = (Header *)ptr - 1;
+    uint32_t old_usable = block_usable_size(ptr);
+    if (block_resize(ptr, size) == 0)
+    {
+        heap_used = heap_used - old_usable + block_usable_size(ptr);
+        if (heap_used > heap_peak)
+        {
+            heap_peak = heap_used;
+        }
+        HEAP_TRACE_EVENT(HEAP_TRACE_REALLOC, size, ptr);
+        return ptr;
+    }
 
-    uint32_t old_data_size = (old_hdr->s.size - 1) * sizeof(Header);
     void *newptr = malloc(size);
-    if (newptr)
+    if (!newptr)
     {
-        char *src = (char *)ptr;
-        char *dst = (char *)newptr;
-
-        uint32_t copy_bytes = (size < old_data_size) ? size : old_data_size;
-        for (uint32_t i = 0; i < copy_bytes; i++)
-            dst[i] = src[i];
+        return 0;
     }
+    memcpy(newptr, ptr, (size < old_usable) ? size : old_usable);
     free(ptr);
     return newptr;
 }
 
 void *calloc(uint32_t nmemb, uint32_t size)
 {
+    if (size != 0 && nmemb > 0xFFFFFFFFU / size)
+    {
+        return 0;
+    }
     uint32_t total = nmemb * size;
     void *ptr = malloc(total);
     if (ptr)
     {
-        char *p = (char *)ptr;
-        for (uint32_t i = 0; i < total; i++)
-            p[i] = 0;
+        memset(ptr, 0, total);
     }
     return ptr;
 }
 
+void heap_get_stats(heap_stats_t *stats)
+{
+    uint32_t untouched = heap_free_space();
+
+    stats->free_bytes = untouched;
+    stats->largest_free = untouched;
+    stats->free_blocks = 0;
+    heap_walk_free(stats);
+
+    stats->used_bytes = heap_used;
+    stats->peak_used = heap_peak;
+    stats->alloc_count = heap_alloc_count;
+    stats->free_count = heap_free_count;
+    stats->fail_count = heap_fail_count;
+}
+
+// ----------------------- WGR-V -----------------------
+//
+//                        pool
+//
+//------------------------------------------------------
+
+int32_t pool_init(pool_t *pool, uint32_t obj_size, uint32_t count)
+{
+    obj_size = (obj_size + 3) & ~3U;
+    if (obj_size < sizeof(void *))
+    {
+        obj_size = sizeof(void *);
+    }
+
+    pool->free_list = 0;
+    pool->obj_size = obj_size;
+    pool->capacity = 0;
+    pool->used = 0;
+    pool->peak = 0;
+    pool->alloc_count = 0;
+    pool->fail_count = 0;
+
+    if (count == 0 || obj_size > (uint32_t)(&_heap_end - heap_ptr) / count)
+    {
+        pool->start = pool->end = 0;
+        return -1;
+    }
+
+    uint8_t *mem = (uint8_t *)sbrk(obj_size * count);
+    if (mem == (uint8_t *)-1)
+    {
+        pool->start = pool->end = 0;
+        return -1;
+    }
+
+    pool->start = mem;
+    pool->end = mem + obj_size * count;
+    pool->capacity = count;
+
+    // Freiliste in Speicherreihenfolge aufbauen
+    void **obj = (void **)mem;
+    for (uint32_t i = 1; i < count; i++)
+    {
+        void **next = (void **)((uint8_t *)obj + obj_size);
+        *obj = next;
+        obj = next;
+    }
+    *obj = 0;
+    pool->free_list = mem;
+    return 0;
+}
+
+void *pool_alloc(pool_t *pool)
+{
+    void **obj = (void **)pool->free_list;
+    if (!obj)
+    {
+        pool->fail_count++;
+        return 0;
+    }
+    pool->free_list = *obj;
+    pool->alloc_count++;
+    if (++pool->used > pool->peak)
+    {
+        pool->peak = pool->used;
+    }
+    return obj;
+}
+
+void pool_free(pool_t *pool, void *ptr)
+{
+    uint8_t *obj = (uint8_t *)ptr;
+
+    // Fremde oder nicht auf Blockgrenzen liegende Zeiger würden die Freiliste zerstören
+    if (!obj || obj < pool->start || obj >= pool->end ||
+        (uint32_t)(obj - pool->start) % pool->obj_size != 0)
+    {
+        return;
+    }
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->used--;
+}
+
+// ----------------------- WGR-V -----------------------
+//
+//                        arena
+//
+//------------------------------------------------------
+
+int32_t arena_create(arena_t *arena, uint32_t size)
+{
+    size = (size + 3) & ~3U;
+    uint8_t *mem = (uint8_t *)-1;
+    if (size <= (uint32_t)(&_heap_end - heap_ptr))
+    {
+        mem = (uint8_t *)sbrk((int32_t)size);
+    }
+    if (mem == (uint8_t *)-1)
+    {
+        arena->base = arena->ptr = arena->end = 0;
+        arena->high_water = 0;
+        return -1;
+    }
+    arena->base = mem;
+    arena->ptr = mem;
+    arena->end = mem + size;
+    arena->high_water = 0;
+    return 0;
+}
+
+void *arena_alloc(arena_t *arena, uint32_t size, uint32_t align)
+{
+    if (align == 0)
+    {
+        align = 4;
+    }
+    uint32_t addr = ((uint32_t)arena->ptr + align - 1) & ~(align - 1);
+    if (addr > (uint32_t)arena->end || size > (uint32_t)arena->end - addr)
+    {
+        return 0;
+    }
+    arena->ptr = (uint8_t *)(addr + size);
+
+    uint32_t used = (uint32_t)(arena->ptr - arena->base);
+    if (used > arena->high_water)
+    {
+        arena->high_water = used;
+    }
+    return (void *)addr;
+}
+
+uint32_t arena_mark(const arena_t *arena)
+{
+    return (uint32_t)(arena->ptr - arena->base);
+}
+
+void arena_reset(arena_t *arena, uint32_t mark)
+{
+    arena->ptr = arena->base + mark;
+}
+
 #endif
 
 #ifdef SSD1351
@@ -715,6 +1956,18 @@ static uint16_t __attribute__((aligned(4))) term_text_color = COLOR_WHITE;
 static uint16_t __attribute__((aligned(4))) term_bg_color = COLOR_BLACK;
 static uint16_t __attribute__((aligned(4))) cursor_visible = true;
 
+// Statische Pixelpuffer, damit DMA-Transfers über das Funktionsende hinaus laufen können
+static uint16_t __attribute__((aligned(4))) ssd1351_line_buf[SSD1351_WIDTH];
+static uint16_t __attribute__((aligned(4))) ssd1351_cell_buf[2][CHAR_WIDTH * CHAR_HEIGHT];
+static uint32_t ssd1351_cell_sel = 0;
+
+#ifdef DMA
+// Kleinere Transfers lohnen den DMA nicht und kommen oft vom Stack
+#define SSD1351_DMA_MIN_LEN 16
+
+static uint32_t ssd1351_dma_active = 0;
+#endif
+
 void housekeeping(void)
 {
     uint32_t last_hk_time = 0;
@@ -752,16 +2005,40 @@ void ssd1351_inv(void)
     }
 }
 
+void ssd1351_flush(void)
+{
+#ifdef DMA
+    if (ssd1351_dma_active)
+    {
+        dma_wait(SSD1351_SPI_TIMEOUT);
+        spi_cs(0);
+        ssd1351_dma_active = 0;
+    }
+#endif
+}
+
 void ssd1351_send_data(const uint8_t *data, size_t len)
 {
+    ssd1351_flush();
     gpio_write_pin(0, 1);
     spi_cs(1);
+#ifdef DMA
+    if (len >= SSD1351_DMA_MIN_LEN)
+    {
+        // Chip Select bleibt aktiv, ssd1351_flush beendet den Transfer
+        dma_start(data, (volatile void *)(SPI_BASE_ADDR + SPI_TX_OFFSET), len,
+                  DMA_CTRL_SIZE_8 | DMA_CTRL_SRC_INC | DMA_CTRL_PACE_SPI);
+        ssd1351_dma_active = 1;
+        return;
+    }
+#endif
     spi_write_buffer(data, len, SSD1351_SPI_TIMEOUT);
     spi_cs(0);
 }
 
 void ssd1351_send_command(uint8_t cmd)
 {
+    ssd1351_flush();
     gpio_write_pin(0, 0);
     spi_cs(1);
     spi_write_byte(cmd, SSD1351_SPI_TIMEOUT);
@@ -770,6 +2047,7 @@ void ssd1351_send_command(uint8_t cmd)
 
 void ssd1351_send_command_with_data(uint8_t cmd, const uint8_t *data, size_t len)
 {
+    ssd1351_flush();
     spi_cs(1);
     gpio_write_pin(0, 0);
     spi_write_byte(cmd, SSD1351_SPI_TIMEOUT);
@@ -795,6 +2073,7 @@ void ssd1351_send_commands(const uint8_t *buf, size_t len)
 
 void ssd1351_init(void)
 {
+    ssd1351_flush();
     spi_cs(0);
 
     gpio_write_pin(1, 0);
@@ -830,6 +2109,24 @@ void ssd1351_set_position(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
     ssd1351_send_command(0x5C);
 }
 
+/**
+ * @brief Sendet rows volle Displayzeilen in einer Farbe aus ssd1351_line_buf.
+ *
+ * Die Position muss vorher gesetzt sein. Die letzte Zeile läuft per DMA weiter.
+ */
+static void ssd1351_fill_lines(uint16_t color, uint32_t rows)
+{
+    ssd1351_flush();
+    for (int i = 0; i < SSD1351_WIDTH; i++)
+    {
+        ssd1351_line_buf[i] = color;
+    }
+    for (uint32_t r = 0; r < rows; r++)
+    {
+        ssd1351_send_data((uint8_t *)ssd1351_line_buf, sizeof(ssd1351_line_buf));
+    }
+}
+
 void draw_char_cell_custom(uint8_t row, uint8_t col, char c, uint16_t fg, uint16_t bg)
 {
     if (c < 32 || c > 127)
@@ -843,7 +2140,10 @@ void draw_char_cell_custom(uint8_t row, uint8_t col, char c, uint16_t fg, uint16
 
     ssd1351_set_position(x, y, CHAR_WIDTH, CHAR_HEIGHT);
 
-    uint16_t cell[CHAR_WIDTH * CHAR_HEIGHT];
+    // Abwechselnd zwei Puffer, der vorherige kann noch per DMA gesendet werden
+    uint16_t *cell = ssd1351_cell_buf[ssd1351_cell_sel];
+    ssd1351_cell_sel ^= 1;
+
     for (int i = 0; i < (CHAR_WIDTH * CHAR_HEIGHT); i++)
     {
         cell[i] = bg;
@@ -859,7 +2159,7 @@ void draw_char_cell_custom(uint8_t row, uint8_t col, char c, uint16_t fg, uint16
             }
         }
     }
-    ssd1351_send_data((const uint8_t *)cell, sizeof(cell));
+    ssd1351_send_data((const uint8_t *)cell, sizeof(ssd1351_cell_buf[0]));
 }
 
 void draw_char_cell(uint8_t row, uint8_t col, char c)
@@ -888,13 +2188,7 @@ void clear_terminal(void)
 void draw_status_bar(const char *text, uint16_t bg_color, uint16_t fg_color)
 {
     ssd1351_set_position(0, 0, SSD1351_WIDTH, CHAR_HEIGHT);
-
-    uint16_t lineBuf[SSD1351_WIDTH * CHAR_HEIGHT];
-    for (int i = 0; i < SSD1351_WIDTH * CHAR_HEIGHT; i++)
-    {
-        lineBuf[i] = bg_color;
-    }
-    ssd1351_send_data((uint8_t *)lineBuf, sizeof(lineBuf));
+    ssd1351_fill_lines(bg_color, CHAR_HEIGHT);
 
     uint8_t col = 0;
     while (*text && col < TERM_COLS)
@@ -1026,15 +2320,7 @@ void terminal_draw_text_default(uint8_t row, uint8_t col, const char *str)
 void ssd1351_fill_screen(uint16_t color)
 {
     ssd1351_set_position(0, 0, SSD1351_WIDTH, SSD1351_HEIGHT);
-    uint16_t lineBuf[SSD1351_WIDTH];
-    for (int i = 0; i < SSD1351_WIDTH; i++)
-    {
-        lineBuf[i] = color;
-    }
-    for (int r = 0; r < SSD1351_HEIGHT; r++)
-    {
-        ssd1351_send_data((uint8_t *)lineBuf, sizeof(lineBuf));
-    }
+    ssd1351_fill_lines(color, SSD1351_HEIGHT);
 }
 
 void ssd1351_draw_pixel(uint8_t x, uint8_t y, uint16_t color)
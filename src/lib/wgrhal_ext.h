@@ -4,7 +4,8 @@
  *
  * Diese Header-Datei erweitert die Basisfunktionen um Hardwareunterstützung für
  * Multiplikation, Division, SPI-Kommunikation, WS2812B LED-Steuerung, PWM-basierte
- * Tonerzeugung, dynamischen Speicher (malloc) sowie ein SSD1351 Display mit Terminal-Funktionen.
+ * Tonerzeugung, dynamischen Speicher (malloc), DMA-Transfers sowie ein SSD1351 Display mit
+ * Terminal-Funktionen.
  */
 
 #ifndef WGRHAL_EXT_H
@@ -24,6 +25,18 @@
  *  @brief Offset für das Informationsregister des Multiplikators.
  */
 #define MULT_INFO_OFFSET 0x0000
+/** @def MULT_INFO_BUSY
+ *  @brief Busy-Bit im Informationsregister des Multiplikators.
+ */
+#define MULT_INFO_BUSY 0x00000001
+/** @def MULT_INFO_LAT_SHIFT
+ *  @brief Position der maximalen Latenz (8 Bit, Takte) im Informationsregister.
+ */
+#define MULT_INFO_LAT_SHIFT 8
+/** @def MULT_INFO_EARLY
+ *  @brief Gesetzt, wenn der Multiplikator bei kleinen Operanden vorzeitig endet.
+ */
+#define MULT_INFO_EARLY 0x00010000
 /** @def MUL1_OFFSET
  *  @brief Offset für den ersten Multiplikanden.
  */
@@ -65,6 +78,14 @@
  *  @brief Offset für den Rest.
  */
 #define DIV_REM_OFFSET 0x10
+/** @def DIV_SSOR_OFFSET
+ *  @brief Offset für den Divisor einer vorzeichenbehafteten Division.
+ */
+#define DIV_SSOR_OFFSET 0x14
+/** @def DIV_LAT_OFFSET
+ *  @brief Offset für die Latenz der letzten Division in Takten.
+ */
+#define DIV_LAT_OFFSET 0x18
 
 /** @def SPI_BASE_ADDR
  *  @brief Basisadresse für die SPI-Schnittstelle.
@@ -94,12 +115,141 @@
  *  @brief Offset für die SPI-Chipselect-Steuerung.
  */
 #define SPI_CS_OFFSET 0x0014
+/** @def SPI_TX_LEVEL_OFFSET
+ *  @brief Offset für den Füllstand des SPI-Sende-FIFOs.
+ */
+#define SPI_TX_LEVEL_OFFSET 0x0018
+/** @def SPI_RX_LEVEL_OFFSET
+ *  @brief Offset für den Füllstand des SPI-Empfangs-FIFOs.
+ */
+#define SPI_RX_LEVEL_OFFSET 0x001C
+/** @def SPI_TX_READ_OFFSET
+ *  @brief Offset zum Schreiben in den SPI-Sende-FIFO mit gesetztem Lese-Flag.
+ */
+#define SPI_TX_READ_OFFSET 0x0020
+/** @def SPI_CTRL_FRAME_SHIFT
+ *  @brief Position der Rahmenbreite (2 Bit) im SPI-Steuerregister.
+ */
+#define SPI_CTRL_FRAME_SHIFT 2
+/** @def SPI_FRAME_8
+ *  @brief Kodierung für 8-Bit-Rahmen.
+ */
+#define SPI_FRAME_8 0
+/** @def SPI_FRAME_16
+ *  @brief Kodierung für 16-Bit-Rahmen.
+ */
+#define SPI_FRAME_16 1
+/** @def SPI_FRAME_32
+ *  @brief Kodierung für 32-Bit-Rahmen.
+ */
+#define SPI_FRAME_32 2
+/** @def SPI_TX_FIFO_DEPTH
+ *  @brief Tiefe des SPI-Sende-FIFOs (SPI_FIFO_TX_DEPTH in defines.v).
+ */
+#define SPI_TX_FIFO_DEPTH 4
+/** @def SPI_RX_FIFO_DEPTH
+ *  @brief Tiefe des SPI-Empfangs-FIFOs (SPI_FIFO_RX_DEPTH in defines.v).
+ */
+#define SPI_RX_FIFO_DEPTH 4
+/** @def SPI_READ_FLAG
+ *  @brief Bit im TX-Wort, das den empfangenen Wert in den RX-FIFO schreiben lässt.
+ */
+#define SPI_READ_FLAG 0x00000100
+/** @def SPI_READ_DUMMY
+ *  @brief Byte, das während eines Lesezugriffs auf MOSI gesendet wird.
+ */
+#define SPI_READ_DUMMY 0xFF
 
 /** @def WS_BASE_ADDR
  *  @brief Basisadresse für die WS2812B LED-Steuerung.
  */
 #define WS_BASE_ADDR 0x00000900
 
+/** @def DMA_BASE_ADDR
+ *  @brief Basisadresse für den DMA-Controller.
+ */
+#define DMA_BASE_ADDR 0x00000A00
+/** @def DMA_CTRL_OFFSET
+ *  @brief Offset für das DMA-Steuerregister.
+ */
+#define DMA_CTRL_OFFSET 0x00
+/** @def DMA_SRC_OFFSET
+ *  @brief Offset für die DMA-Quelladresse.
+ */
+#define DMA_SRC_OFFSET 0x04
+/** @def DMA_DST_OFFSET
+ *  @brief Offset für die DMA-Zieladresse.
+ */
+#define DMA_DST_OFFSET 0x08
+/** @def DMA_LEN_OFFSET
+ *  @brief Offset für die Anzahl der (verbleibenden) Elemente.
+ */
+#define DMA_LEN_OFFSET 0x0C
+/** @def DMA_STATUS_OFFSET
+ *  @brief Offset für das DMA-Statusregister.
+ */
+#define DMA_STATUS_OFFSET 0x10
+/** @def DMA_CTRL_START
+ *  @brief Startet den Transfer (gelesen: Transfer läuft).
+ */
+#define DMA_CTRL_START (1U << 0)
+/** @def DMA_CTRL_SIZE_8
+ *  @brief Elementgröße 8 Bit.
+ */
+#define DMA_CTRL_SIZE_8 (0U << 1)
+/** @def DMA_CTRL_SIZE_16
+ *  @brief Elementgröße 16 Bit.
+ */
+#define DMA_CTRL_SIZE_16 (1U << 1)
+/** @def DMA_CTRL_SIZE_32
+ *  @brief Elementgröße 32 Bit.
+ */
+#define DMA_CTRL_SIZE_32 (2U << 1)
+/** @def DMA_CTRL_SRC_INC
+ *  @brief Quelladresse nach jedem Element erhöhen.
+ */
+#define DMA_CTRL_SRC_INC (1U << 3)
+/** @def DMA_CTRL_DST_INC
+ *  @brief Zieladresse nach jedem Element erhöhen.
+ */
+#define DMA_CTRL_DST_INC (1U << 4)
+/** @def DMA_CTRL_PACE_UART
+ *  @brief Nur übertragen, solange der UART-TX-FIFO nicht voll ist.
+ */
+#define DMA_CTRL_PACE_UART (1U << 5)
+/** @def DMA_CTRL_PACE_SPI
+ *  @brief Nur übertragen, solange der SPI-TX-FIFO nicht voll ist.
+ */
+#define DMA_CTRL_PACE_SPI (2U << 5)
+/** @def DMA_STATUS_BUSY
+ *  @brief Statusbit: Transfer läuft.
+ */
+#define DMA_STATUS_BUSY (1U << 0)
+/** @def DMA_STATUS_DONE
+ *  @brief Statusbit: Transfer abgeschlossen.
+ */
+#define DMA_STATUS_DONE (1U << 1)
+
+/** @def UDIV_CLOG2_4
+ *  @brief Hilfsmakro für UDIV_CLOG2: zählt, wie viele der Zweierpotenzen 2^k bis 2^(k+3) kleiner als d sind.
+ */
+#define UDIV_CLOG2_4(d, k) (((d) > (1ULL << (k))) + ((d) > (1ULL << ((k) + 1))) + \
+                            ((d) > (1ULL << ((k) + 2))) + ((d) > (1ULL << ((k) + 3))))
+/** @def UDIV_CLOG2
+ *  @brief Aufgerundeter Zweierlogarithmus einer Konstanten (0 bis 32), wird vom Compiler ausgewertet.
+ */
+#define UDIV_CLOG2(d) (UDIV_CLOG2_4(d, 0) + UDIV_CLOG2_4(d, 4) + UDIV_CLOG2_4(d, 8) + \
+                       UDIV_CLOG2_4(d, 12) + UDIV_CLOG2_4(d, 16) + UDIV_CLOG2_4(d, 20) + \
+                       UDIV_CLOG2_4(d, 24) + UDIV_CLOG2_4(d, 28))
+/** @def UDIV_CONST
+ *  @brief Initialisierer für ein udiv_const_t mit konstantem Divisor d (d > 0), wird vom Compiler berechnet.
+ */
+#define UDIV_CONST(d) {                                                                  \
+    (uint32_t)(((((1ULL << UDIV_CLOG2(d)) - (d)) << 32) / (d)) + 1),                     \
+    (uint32_t)(d),                                                                        \
+    (uint8_t)(UDIV_CLOG2(d) > 0 ? 1 : 0),                                                 \
+    (uint8_t)(UDIV_CLOG2(d) > 0 ? UDIV_CLOG2(d) - 1 : 0)}
+
 /** @brief Struktur zur Darstellung einer RGB-Farbe.
  */
 typedef struct
@@ -119,6 +269,19 @@ typedef struct
     uint32_t remainder; /**< Rest */
 } div_result_t;
 
+/** @brief Vorberechneter Kehrwert für die Division durch einen festen Divisor.
+ *
+ * Verfahren nach Granlund und Montgomery (wie in libdivide): n / d ergibt sich
+ * aus t = (magic * n) >> 32 als (t + ((n - t) >> shift1)) >> shift2.
+ */
+typedef struct
+{
+    uint32_t magic;   /**< floor(2^32 * (2^l - d) / d) + 1 mit l = ceil(log2(d)) */
+    uint32_t divisor; /**< Divisor d */
+    uint8_t shift1;   /**< min(l, 1) */
+    uint8_t shift2;   /**< max(l - 1, 0) */
+} udiv_const_t;
+
 /* Hardware Multiplication and Division */
 /**
  * @brief Berechnet das 64-Bit-Ergebnis einer Multiplikation.
@@ -166,6 +329,163 @@ uint32_t div_calc_quotient(uint32_t dividend, uint32_t divisor);
  */
 uint32_t div_calc_remainder(uint32_t dividend, uint32_t divisor);
 
+/**
+ * @brief Führt eine vorzeichenbehaftete Division in der Hardware durch.
+ *
+ * Der Quotient wird Richtung 0 gerundet, der Rest hat das Vorzeichen des
+ * Dividenden. Quotient und Rest werden als int32_t-Bitmuster abgelegt.
+ *
+ * @param dividend Dividend.
+ * @param divisor Divisor.
+ * @param result Zeiger auf eine div_result_t-Struktur, in der Quotient und Rest gespeichert werden.
+ * @return 0 bei Erfolg, -1 bei Fehler (z.B. Division durch 0 oder ungültiger Pointer).
+ */
+int32_t div_calc_signed(int32_t dividend, int32_t divisor, div_result_t *result);
+
+/**
+ * @brief Liefert die gemessene Latenz der letzten Hardware-Division in Takten.
+ *
+ * Der Wert beschreibt die bereits abgeschlossene Division und eignet sich
+ * zum Profiling. Für die Entscheidung vor einer Division dient
+ * div_predict_latency.
+ *
+ * @return Anzahl der Takte, die die letzte Division belegt war (2 bis 18).
+ */
+uint32_t div_get_latency(void);
+
+/**
+ * @brief Berechnet die Latenz einer Hardware-Division im Voraus.
+ *
+ * Der Divider überspringt führende Nullbits des Dividenden und benötigt
+ * 2 + ceil(q / 2) Takte mit q = nlz(Divisor) - nlz(Dividend) + 1, bzw.
+ * 2 Takte, wenn der Dividend kleiner als der Divisor oder der Divisor 0 ist.
+ * Für vorzeichenbehaftete Divisionen sind die Beträge zu übergeben.
+ *
+ * @param dividend Dividend (Betrag).
+ * @param divisor Divisor (Betrag).
+ * @return Anzahl der Takte, die die Division belegen wird (2 bis 18).
+ */
+uint32_t div_predict_latency(uint32_t dividend, uint32_t divisor);
+
+/**
+ * @brief Startet eine Multiplikation, ohne auf das Ergebnis zu warten.
+ *
+ * Der Multiplikator darf bis zu mult_collect nicht erneut beschrieben werden.
+ *
+ * @param multiplicand Erster Faktor.
+ * @param multiplier Zweiter Faktor, das Schreiben startet die Berechnung.
+ */
+void mult_start(uint32_t multiplicand, uint32_t multiplier);
+
+/**
+ * @brief Prüft, ob die mit mult_start gestartete Multiplikation noch läuft.
+ *
+ * @return 1, wenn der Multiplikator beschäftigt ist, sonst 0.
+ */
+uint32_t mult_busy(void);
+
+/**
+ * @brief Liefert die maximale Latenz des Hardware-Multiplikators.
+ *
+ * Die Latenz hängt von der in defines.v gewählten Implementierung ab:
+ * 0 (DSP, Ergebnis sofort gültig), 17 (Radix-4-Booth) oder 32 Takte.
+ * Mit MULT_INFO_EARLY endet die Berechnung bei kleinen Operanden früher.
+ *
+ * @return Maximale Anzahl Takte, die der Multiplikator belegt ist.
+ */
+uint32_t mult_get_latency(void);
+
+/**
+ * @brief Wartet auf die laufende Multiplikation und liefert das 64-Bit-Ergebnis.
+ *
+ * @return 64-Bit-Ergebnis der Multiplikation.
+ */
+uint64_t mult_collect_64(void);
+
+/**
+ * @brief Wartet auf die laufende Multiplikation und liefert die unteren 32 Bit.
+ *
+ * @return Niederwertiger 32-Bit-Teil des Multiplikationsergebnisses.
+ */
+uint32_t mult_collect(void);
+
+/**
+ * @brief Startet eine Division, ohne auf das Ergebnis zu warten.
+ *
+ * Der Divider darf bis zu div_collect nicht erneut beschrieben werden.
+ *
+ * @param dividend Dividend.
+ * @param divisor Divisor, das Schreiben startet die Berechnung.
+ * @return 0 bei Erfolg, -1 bei Division durch 0 (es wird nichts gestartet).
+ */
+int32_t div_start(uint32_t dividend, uint32_t divisor);
+
+/**
+ * @brief Prüft, ob die mit div_start gestartete Division noch läuft.
+ *
+ * @return 1, wenn der Divider beschäftigt ist, sonst 0.
+ */
+uint32_t div_busy(void);
+
+/**
+ * @brief Wartet auf die laufende Division und liefert Quotient und Rest.
+ *
+ * @param result Zeiger auf eine div_result_t-Struktur für Quotient und Rest.
+ */
+void div_collect(div_result_t *result);
+
+/**
+ * @brief Multipliziert n Elementpaare, out[i] = a[i] * b[i] (untere 32 Bit).
+ *
+ * Während der Multiplikator rechnet, werden die nächsten Operanden geladen und
+ * das vorherige Ergebnis gespeichert.
+ *
+ * @param a Erste Faktoren.
+ * @param b Zweite Faktoren.
+ * @param out Zielarray für die Produkte.
+ * @param n Anzahl der Elemente.
+ */
+void mult_array(const uint32_t *a, const uint32_t *b, uint32_t *out, uint32_t n);
+
+/**
+ * @brief Dividiert n Elementpaare mit Rest, verzahnt wie mult_array.
+ *
+ * Bei Divisor 0 ist der Quotient 0xFFFFFFFF und der Rest der Dividend, wie
+ * beim Divider und nach RISC-V-Semantik.
+ *
+ * @param dividend Dividenden.
+ * @param divisor Divisoren.
+ * @param quotient Zielarray für die Quotienten.
+ * @param remainder Zielarray für die Reste oder NULL.
+ * @param n Anzahl der Elemente.
+ */
+void divmod_array(const uint32_t *dividend, const uint32_t *divisor, uint32_t *quotient,
+                  uint32_t *remainder, uint32_t n);
+
+/**
+ * @brief Berechnet den Kehrwert für einen erst zur Laufzeit bekannten Divisor.
+ *
+ * Für Konstanten wird stattdessen UDIV_CONST verwendet.
+ *
+ * @param d Zu initialisierende Struktur.
+ * @param divisor Divisor, muss größer als 0 sein.
+ * @return 0 bei Erfolg, -1 bei Divisor 0 oder ungültigem Pointer.
+ */
+int32_t udiv_const_init(udiv_const_t *d, uint32_t divisor);
+
+/**
+ * @brief Dividiert durch einen vorberechneten Divisor.
+ *
+ * Mit UDIV_HW_MULT über das obere Wort des Hardware-Multiplikators statt über
+ * die 32 Schritte von __udivsi3, sonst als gewöhnliche Division. UDIV_HW_MULT
+ * darf nur auf Zielen mit seq_multiplier gesetzt werden.
+ *
+ * @param n Dividend.
+ * @param d Mit UDIV_CONST oder udiv_const_init vorbereiteter Divisor.
+ * @return n / d->divisor.
+ */
+uint32_t udiv_const_div(uint32_t n, const udiv_const_t *d);
+
 /* SPI Functions */
 /**
  * @brief Aktiviert die SPI-Schnittstelle.
@@ -205,6 +525,23 @@ void spi_set_clock_offet(uint32_t offset);
  */
 void spi_set_clock_divider(uint32_t divider);
 
+/**
+ * @brief Setzt die Rahmenbreite für nachfolgend eingereihte SPI-Einträge.
+ *
+ * Die Breite wird mit jedem Eintrag im FIFO gespeichert, bereits eingereihte
+ * Rahmen behalten ihre Breite. Die Byte-Funktionen setzen 8 Bit voraus.
+ *
+ * @param bits Rahmenbreite in Bit (8, 16 oder 32, andere Werte ergeben 8).
+ */
+void spi_set_frame_width(uint32_t bits);
+
+/**
+ * @brief Liest die eingestellte Rahmenbreite.
+ *
+ * @return Rahmenbreite in Bit (8, 16 oder 32).
+ */
+uint32_t spi_get_frame_width(void);
+
 /**
  * @brief Liest den aktuellen Status der SPI-Schnittstelle.
  *
@@ -261,6 +598,20 @@ uint32_t spi_tx_full(void);
  */
 uint32_t spi_tx_empty(void);
 
+/**
+ * @brief Liefert die Anzahl freier Plätze im SPI-Sende-FIFO.
+ *
+ * @return Anzahl der Einträge, die ohne Warten geschrieben werden können.
+ */
+uint32_t spi_tx_free(void);
+
+/**
+ * @brief Liefert die Anzahl der Bytes im SPI-Empfangs-FIFO.
+ *
+ * @return Anzahl der Bytes, die ohne Warten gelesen werden können.
+ */
+uint32_t spi_rx_avail(void);
+
 /**
  * @brief Wartet darauf, dass Daten im SPI-Empfangspuffer verfügbar sind.
  *
@@ -306,9 +657,43 @@ int32_t spi_write_buffer(const uint8_t *buf, uint32_t length, uint32_t timeout_m
  */
 int32_t spi_write_uint32(uint32_t value, uint32_t timeout_ms);
 
+/**
+ * @brief Sendet ein Feld von Wörtern als 16- oder 32-Bit-Rahmen über SPI.
+ *
+ * Von jedem Wort werden die unteren bits Bit gesendet, MSB zuerst. Ein
+ * Schreibzugriff auf den FIFO überträgt damit bis zu 4 Byte. Die vorherige
+ * Rahmenbreite wird danach wiederhergestellt.
+ *
+ * @param buf Zeiger auf die zu sendenden Wörter.
+ * @param count Anzahl der Wörter.
+ * @param bits Rahmenbreite in Bit (8, 16 oder 32).
+ * @param timeout_ms Zeitlimit in Millisekunden.
+ * @return 0 bei Erfolg, -1 bei Fehler.
+ */
+int32_t spi_write_words(const uint32_t *buf, uint32_t count, uint32_t bits, uint32_t timeout_ms);
+
+/**
+ * @brief Sendet und empfängt gleichzeitig einen Datenpuffer über SPI (Vollduplex).
+ *
+ * Jedes Byte aus tx wird mit gesetztem SPI_READ_FLAG gesendet, das dabei
+ * empfangene Byte landet an derselben Position in rx. Wie bei
+ * spi_read_buffer sind bis zu SPI_RX_FIFO_DEPTH Bytes gleichzeitig unterwegs.
+ *
+ * @param tx Zu sendende Daten oder NULL, um SPI_READ_DUMMY zu senden.
+ * @param rx Zielpuffer oder NULL, um nur zu senden.
+ * @param length Anzahl der Bytes.
+ * @param timeout_ms Zeitlimit in Millisekunden.
+ * @return 0 bei Erfolg, -1 bei Fehler.
+ */
+int32_t spi_transfer_buffer(const uint8_t *tx, uint8_t *rx, uint32_t length, uint32_t timeout_ms);
+
 /**
  * @brief Liest einen Datenpuffer von der SPI-Schnittstelle.
  *
+ * Es werden bis zu SPI_RX_FIFO_DEPTH Lese-Token gleichzeitig in den
+ * Sende-FIFO gelegt, während der Empfangs-FIFO geleert wird, sodass der
+ * SPI-Takt zwischen den Bytes nicht stillsteht.
+ *
  * @param buf Zeiger auf den Zielpuffer.
  * @param length Länge des Puffers.
  * @param timeout_ms Zeitlimit in Millisekunden.
@@ -355,6 +740,73 @@ int32_t ws2812_fill(rgb_color_t color);
  */
 void ws2812_clear(void);
 
+/* DMA Functions */
+/**
+ * @brief Startet einen DMA-Transfer.
+ *
+ * Der DMA übernimmt den Bus jeweils zwischen zwei Instruktionen der CPU
+ * für ein Element. Die Quelle muss bis zum Ende des Transfers gültig
+ * bleiben. Das Ziel wird immer als ganzes Wort geschrieben.
+ *
+ * @param src Quelladresse.
+ * @param dst Zieladresse, z. B. ein TX-Register.
+ * @param count Anzahl der Elemente.
+ * @param ctrl Kombination aus DMA_CTRL_SIZE_*, DMA_CTRL_*_INC und DMA_CTRL_PACE_*.
+ */
+void dma_start(const volatile void *src, volatile void *dst, uint32_t count, uint32_t ctrl);
+
+/**
+ * @brief Prüft, ob ein DMA-Transfer läuft.
+ *
+ * @return 1 wenn aktiv, sonst 0.
+ */
+uint32_t dma_busy(void);
+
+/**
+ * @brief Wartet auf das Ende des DMA-Transfers.
+ *
+ * Das Zeitlimit gilt nur, solange kein Element übertragen wird. Bei
+ * Zeitüberschreitung wird der Transfer abgebrochen.
+ *
+ * @param timeout_ms Zeitlimit in Millisekunden.
+ * @return 0 bei Erfolg, -1 bei Zeitüberschreitung.
+ */
+int32_t dma_wait(uint32_t timeout_ms);
+
+/**
+ * @brief Bricht einen laufenden DMA-Transfer nach dem aktuellen Element ab.
+ */
+void dma_abort(void);
+
+/* Stack Functions */
+/** @def STACK_CANARY
+ *  @brief Muster, mit dem crt0.s den Stack beim Start füllt.
+ */
+#define STACK_CANARY 0xDEADBEEF
+
+/**
+ * @brief Start- und Endadressen des Stacks (extern deklariert).
+ */
+extern char _sstack;
+extern char _estack;
+
+/**
+ * @brief Ermittelt die maximale bisherige Stacknutzung.
+ *
+ * Sucht ab _sstack das erste Wort, das nicht mehr STACK_CANARY enthält.
+ * Die Laufzeit wächst mit dem ungenutzten Stackbereich.
+ *
+ * @return Höchste Stacknutzung seit dem Start in Byte.
+ */
+uint32_t stack_high_water(void);
+
+/**
+ * @brief Liefert die Größe des Stackbereichs.
+ *
+ * @return Größe zwischen _sstack und _estack in Byte.
+ */
+uint32_t stack_size(void);
+
 #ifdef PWM_NOTES
 /* Play Frequencies with the PWM Module */
 /**
@@ -406,12 +858,10 @@ void pwm_free_note_buffer(void);
 #ifdef MALLOC
 /* malloc */
 /**
- * @brief Start- und Endadressen des Heaps und Stacks (extern deklariert).
+ * @brief Start- und Endadressen des Heaps (extern deklariert).
  */
 extern char _heap_start;
 extern char _heap_end;
-extern char _sstack;
-extern char _estack;
 
 /**
  * @brief Allokiert einen Speicherblock.
@@ -447,12 +897,157 @@ void *realloc(void *ptr, uint32_t size);
 void *calloc(uint32_t nmemb, uint32_t size);
 
 /**
- * @brief Ermittelt den aktuell freien Heap-Speicher.
+ * @brief Ermittelt den noch nicht per sbrk vergebenen Heap-Speicher.
+ *
+ * Freie Blöcke in den Freilisten von malloc sind nicht enthalten,
+ * siehe heap_get_stats.
  *
  * @return Freier Speicher in Byte.
  */
 uint32_t heap_free_space(void);
 
+/** @def HEAP_TRACE_MALLOC
+ *  @brief Trace-Ereignis: malloc erfolgreich.
+ */
+#define HEAP_TRACE_MALLOC 0x01
+/** @def HEAP_TRACE_FREE
+ *  @brief Trace-Ereignis: free.
+ */
+#define HEAP_TRACE_FREE 0x02
+/** @def HEAP_TRACE_REALLOC
+ *  @brief Trace-Ereignis: realloc ohne Verschieben.
+ */
+#define HEAP_TRACE_REALLOC 0x03
+/** @def HEAP_TRACE_FAIL
+ *  @brief Trace-Ereignis: malloc fehlgeschlagen.
+ */
+#define HEAP_TRACE_FAIL 0x04
+/** @def HEAP_TRACE_SBRK
+ *  @brief Trace-Ereignis: Heap über sbrk erweitert.
+ */
+#define HEAP_TRACE_SBRK 0x05
+
+/** @brief Statistik über den Zustand des Heaps.
+ */
+typedef struct
+{
+    uint32_t free_bytes;   /**< Freie Byte (Freilisten und unberührter Bereich) */
+    uint32_t largest_free; /**< Größter zusammenhängender freier Bereich */
+    uint32_t free_blocks;  /**< Anzahl der Blöcke in den Freilisten */
+    uint32_t used_bytes;   /**< Aktuell allokierte Byte */
+    uint32_t peak_used;    /**< Höchster Wert von used_bytes */
+    uint32_t alloc_count;  /**< Erfolgreiche malloc-Aufrufe */
+    uint32_t free_count;   /**< free-Aufrufe */
+    uint32_t fail_count;   /**< Fehlgeschlagene malloc-Aufrufe */
+} heap_stats_t;
+
+/**
+ * @brief Ermittelt die aktuelle Heap-Statistik.
+ *
+ * Durchläuft die Freilisten, die Laufzeit wächst mit der Anzahl freier Blöcke.
+ * Mit HEAP_TRACE wird zusätzlich jedes Heap-Ereignis über debug_write
+ * ausgegeben (Typ in Bit 31:24, Größe in Bit 23:0, danach die Adresse).
+ *
+ * @param stats Zeiger auf die zu füllende Struktur.
+ */
+void heap_get_stats(heap_stats_t *stats);
+
+/**
+ * @brief Objekt-Pool für Blöcke fester Größe.
+ *
+ * Der Speicher wird einmalig aus dem Heap (sbrk) entnommen. Freie Objekte
+ * bilden eine intrusive Liste, deren Verweis im Objekt selbst liegt.
+ */
+typedef struct
+{
+    void *free_list;       /**< Erstes freies Objekt */
+    uint8_t *start;        /**< Beginn des Pool-Speichers */
+    uint8_t *end;          /**< Ende des Pool-Speichers */
+    uint32_t obj_size;     /**< Objektgröße in Byte (auf 4 Byte gerundet) */
+    uint32_t capacity;     /**< Anzahl der Objekte */
+    uint32_t used;         /**< Aktuell belegte Objekte */
+    uint32_t peak;         /**< Höchste Anzahl gleichzeitig belegter Objekte */
+    uint32_t alloc_count;  /**< Erfolgreiche pool_alloc-Aufrufe */
+    uint32_t fail_count;   /**< Fehlgeschlagene pool_alloc-Aufrufe */
+} pool_t;
+
+/**
+ * @brief Legt einen Pool mit count Objekten der Größe obj_size an.
+ *
+ * @param pool Zeiger auf die Pool-Struktur.
+ * @param obj_size Größe eines Objekts in Byte.
+ * @param count Anzahl der Objekte.
+ * @return 0 bei Erfolg, -1 wenn der Heap nicht ausreicht.
+ */
+int32_t pool_init(pool_t *pool, uint32_t obj_size, uint32_t count);
+
+/**
+ * @brief Entnimmt ein Objekt aus dem Pool.
+ *
+ * @param pool Zeiger auf den Pool.
+ * @return Zeiger auf das Objekt oder NULL, wenn der Pool erschöpft ist.
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * @brief Gibt ein Objekt an den Pool zurück.
+ *
+ * @param pool Zeiger auf den Pool.
+ * @param ptr Zeiger auf das Objekt. NULL sowie Zeiger außerhalb des Pools
+ *            oder nicht auf einem Blockanfang werden ignoriert.
+ */
+void pool_free(pool_t *pool, void *ptr);
+
+/**
+ * @brief Arena für kurzlebige Allokationen, die gemeinsam freigegeben werden.
+ *
+ * arena_alloc verschiebt nur einen Zeiger innerhalb eines per sbrk angelegten
+ * Slabs. Einzelne Blöcke werden nicht freigegeben, stattdessen setzt
+ * arena_reset auf einen mit arena_mark gemerkten Stand zurück.
+ */
+typedef struct
+{
+    uint8_t *base;       /**< Beginn des Slabs */
+    uint8_t *ptr;        /**< Nächste freie Adresse */
+    uint8_t *end;        /**< Ende des Slabs */
+    uint32_t high_water; /**< Höchster Füllstand in Byte */
+} arena_t;
+
+/**
+ * @brief Legt eine Arena mit size Byte aus dem Heap an.
+ *
+ * @param arena Zeiger auf die Arena-Struktur.
+ * @param size Größe des Slabs in Byte.
+ * @return 0 bei Erfolg, -1 wenn der Heap nicht ausreicht.
+ */
+int32_t arena_create(arena_t *arena, uint32_t size);
+
+/**
+ * @brief Allokiert size Byte aus der Arena.
+ *
+ * @param arena Zeiger auf die Arena.
+ * @param size Größe in Byte.
+ * @param align Ausrichtung in Byte (Zweierpotenz, 0 entspricht 4).
+ * @return Zeiger auf den Speicher oder NULL, wenn die Arena voll ist.
+ */
+void *arena_alloc(arena_t *arena, uint32_t size, uint32_t align);
+
+/**
+ * @brief Liefert den aktuellen Füllstand als Marke für arena_reset.
+ *
+ * @param arena Zeiger auf die Arena.
+ * @return Marke (Füllstand in Byte).
+ */
+uint32_t arena_mark(const arena_t *arena);
+
+/**
+ * @brief Gibt alle Allokationen nach der Marke frei.
+ *
+ * @param arena Zeiger auf die Arena.
+ * @param mark Marke aus arena_mark, 0 leert die Arena.
+ */
+void arena_reset(arena_t *arena, uint32_t mark);
+
 #endif
 
 #ifdef SSD1351
@@ -646,11 +1241,22 @@ void ssd1351_inv(void);
 /**
  * @brief Sendet einen Datenpuffer an das SSD1351 Display.
  *
+ * Mit DMA kehrt die Funktion bei größeren Puffern sofort zurück, der Transfer
+ * läuft im Hintergrund weiter. Der Puffer muss bis zum nächsten ssd1351_send_*
+ * Aufruf oder bis ssd1351_flush gültig und unverändert bleiben.
+ *
  * @param data Zeiger auf den Datenpuffer.
  * @param len Länge des Puffers in Byte.
  */
 void ssd1351_send_data(const uint8_t *data, size_t len);
 
+/**
+ * @brief Wartet auf einen laufenden DMA-Transfer zum Display und gibt Chip Select frei.
+ *
+ * Muss vor anderen Zugriffen auf den SPI-Bus aufgerufen werden.
+ */
+void ssd1351_flush(void);
+
 /**
  * @brief Sendet einen einzelnen Befehl an das SSD1351 Display.
  *
@@ -2,6 +2,11 @@
 
 //#define HARDWAREDIVISION
 
+// Newton-Raphson-Division in __divsf3, lohnt sich nur mit Hardware-Multiplikator
+#ifdef HARDWAREDIVISION
+#define FLOAT_DIV_NEWTON
+#endif
+
 typedef union
 {
     float f;
@@ -26,6 +31,13 @@ typedef union
 #define MUL2_OFFSET       0x0008
 #define RESH_OFFSET       0x000C
 #define RESL_OFFSET       0x0010
+#define MULT_INFO_BUSY    0x00000001
+#define MULT_INFO_LAT_SHIFT 8
+#define MULT_INFO_LAT_MASK  0x000000FF
+#define MULT_INFO_EARLY   0x00010000
+
+// Geschätzte Takte einer Iteration der Shift-Add-Schleife in __mulsi3
+#define MULT_SW_CYCLES_PER_BIT 16
 
 #define DIV_BASE_ADDR     0x00000600
 #define DIV_INFO_OFFSET   0x00
@@ -33,13 +45,14 @@ typedef union
 #define DIV_SOR_OFFSET    0x08
 #define DIV_QUO_OFFSET    0x0C
 #define DIV_REM_OFFSET    0x10
+#define DIV_SSOR_OFFSET   0x14
 
 static inline uint64_t mult_calc_64(uint32_t multiplicand, uint32_t multiplier)
 {
     HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = multiplicand;
     HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = multiplier;
 
-    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET));
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY);
 
     uint64_t high = (uint64_t)HWREG32(MULT_BASE_ADDR + RESH_OFFSET);
     uint64_t low  = (uint64_t)HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
@@ -51,11 +64,39 @@ static inline uint32_t mult_calc_32(uint32_t multiplicand, uint32_t multiplier)
     HWREG32(MULT_BASE_ADDR + MUL1_OFFSET) = multiplicand;
     HWREG32(MULT_BASE_ADDR + MUL2_OFFSET) = multiplier;
 
-    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET));
+    while (HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET) & MULT_INFO_BUSY);
 
     return HWREG32(MULT_BASE_ADDR + RESL_OFFSET);
 }
 
+// Operandengrenze für die Software-Multiplikation, 0 = MULT_INFO noch nicht gelesen
+static uint32_t mult_sw_limit;
+
+/**
+ * @brief Liefert die Grenze, unter der __mulsi3 in Software multipliziert.
+ *
+ * Ohne Early-Out belegt der Multiplikator auch bei kleinen Operanden die
+ * volle Latenz aus MULT_INFO. Die Shift-Add-Schleife ist dann schneller,
+ * solange der kleinere Operand weniger Bits hat, als Iterationen in diese
+ * Latenz passen. Mit DSP oder Early-Out wird nur 0 in Software behandelt.
+ * MULT_INFO wird nur beim ersten Aufruf gelesen.
+ */
+static inline uint32_t mult_get_sw_limit(void)
+{
+    if (mult_sw_limit == 0)
+    {
+        uint32_t info = HWREG32(MULT_BASE_ADDR + MULT_INFO_OFFSET);
+        uint32_t bits = 0;
+
+        if (!(info & MULT_INFO_EARLY))
+        {
+            bits = ((info >> MULT_INFO_LAT_SHIFT) & MULT_INFO_LAT_MASK) / MULT_SW_CYCLES_PER_BIT;
+        }
+        mult_sw_limit = 1U << bits;
+    }
+    return mult_sw_limit;
+}
+
 static inline uint32_t div_calc_quotient(uint32_t dividend, uint32_t divisor)
 {
     if (divisor == 0)
@@ -86,6 +127,27 @@ static inline uint32_t div_calc_remainder(uint32_t dividend, uint32_t divisor)
     return HWREG32(DIV_BASE_ADDR + DIV_REM_OFFSET);
 }
 
+// Vorzeichenbehaftet in der Hardware, Divisor 0 liefert -1 bzw. den Dividenden
+static inline int32_t div_calc_signed_quotient(int32_t dividend, int32_t divisor)
+{
+    HWREG32(DIV_BASE_ADDR + DIV_END_OFFSET) = (uint32_t)dividend;
+    HWREG32(DIV_BASE_ADDR + DIV_SSOR_OFFSET) = (uint32_t)divisor;
+
+    while (HWREG32(DIV_BASE_ADDR + DIV_INFO_OFFSET));
+
+    return (int32_t)HWREG32(DIV_BASE_ADDR + DIV_QUO_OFFSET);
+}
+
+static inline int32_t div_calc_signed_remainder(int32_t dividend, int32_t divisor)
+{
+    HWREG32(DIV_BASE_ADDR + DIV_END_OFFSET) = (uint32_t)dividend;
+    HWREG32(DIV_BASE_ADDR + DIV_SSOR_OFFSET) = (uint32_t)divisor;
+
+    while (HWREG32(DIV_BASE_ADDR + DIV_INFO_OFFSET));
+
+    return (int32_t)HWREG32(DIV_BASE_ADDR + DIV_REM_OFFSET);
+}
+
 static inline uint32_t div_get_quotient()
 {
     return HWREG32(DIV_BASE_ADDR + DIV_QUO_OFFSET);
@@ -370,6 +432,42 @@ float __subsf3(float a, float b)
     return __addsf3(a, ub.f);
 }
 
+/**
+ * @brief Vorzeichenloses 32x32-Bit-Produkt mit 64-Bit-Ergebnis.
+ *
+ * Mit HARDWAREDIVISION über den Hardware-Multiplikator, sonst mit vier
+ * 16x16-Teilprodukten, sodass __mulsi3 je höchstens 16 Schritte braucht
+ * und __muldi3 nicht benötigt wird. Wird auch von wgrfix.c verwendet.
+ */
+uint64_t umul_32x32(uint32_t a, uint32_t b)
+{
+#ifdef HARDWAREDIVISION
+    return mult_calc_64(a, b);
+#else
+    uint32_t a_lo = a & 0xFFFF;
+    uint32_t a_hi = a >> 16;
+    uint32_t b_lo = b & 0xFFFF;
+    uint32_t b_hi = b >> 16;
+
+    uint32_t ll = a_lo * b_lo;
+    uint32_t lh = a_lo * b_hi;
+    uint32_t hl = a_hi * b_lo;
+    uint32_t mid = (ll >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+
+    uint32_t lo = (mid << 16) | (ll & 0xFFFF);
+    uint32_t hi = a_hi * b_hi + (lh >> 16) + (hl >> 16) + (mid >> 16);
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+/**
+ * @brief Multipliziert zwei Mantissen (je höchstens 24 Bit) zu einem 48-Bit-Produkt.
+ */
+static inline uint64_t mant_mul_24x24(uint32_t a, uint32_t b)
+{
+    return umul_32x32(a, b);
+}
+
 float __mulsf3(float a, float b)
 {
     float_union ua = {.f = a};
@@ -423,7 +521,7 @@ float __mulsf3(float a, float b)
 
     int exp_result = exp_a + exp_b - FLOAT_BIAS;
 
-    uint64_t product = (uint64_t)mant_a * (uint64_t)mant_b;
+    uint64_t product = mant_mul_24x24(mant_a, mant_b);
 
     uint64_t shifted = product >> 23;
     if (shifted & (1ULL << 24))
@@ -454,6 +552,85 @@ float __mulsf3(float a, float b)
     return res.f;
 }
 
+#ifdef FLOAT_DIV_NEWTON
+/**
+ * @brief Startwerte für den Kehrwert: 2^9 / (1 + (i + 0.5) / 64) - 256.
+ */
+static const uint8_t recip_seed[64] = {
+    252, 244, 237, 229, 222, 215, 209, 202, 196, 190, 184, 178, 172, 167, 161, 156,
+    151, 146, 141, 136, 132, 127, 123, 118, 114, 110, 106, 102,  98,  94,  91,  87,
+     84,  80,  77,  73,  70,  67,  64,  61,  58,  55,  52,  49,  46,  43,  41,  38,
+     35,  33,  30,  28,  25,  23,  21,  18,  16,  14,  11,   9,   7,   5,   3,   1,
+};
+
+/**
+ * @brief Obere 32 Bit des 64-Bit-Produkts zweier 32-Bit-Werte.
+ */
+static inline uint32_t mul32_hi(uint32_t a, uint32_t b)
+{
+    return (uint32_t)(umul_32x32(a, b) >> 32);
+}
+#endif
+
+/**
+ * @brief Ganzzahliger Quotient floor(mant_a * 2^24 / mant_b) für mant_a, mant_b in [2^23, 2^25)
+ *        mit mant_a >= mant_b und mant_a < 2 * mant_b.
+ *
+ * Ohne FLOAT_DIV_NEWTON per Schiebe-Subtrahier-Division (25 Schritte in 32 Bit).
+ * Mit FLOAT_DIV_NEWTON wird der Kehrwert von mant_b aus recip_seed geschätzt,
+ * mit zwei Newton-Raphson-Schritten auf etwa 26 Bit verfeinert und der Quotient
+ * anschließend über den exakten Rest korrigiert.
+ *
+ * @param sticky Wird auf 1 gesetzt, wenn der Rest ungleich 0 ist.
+ * @return Quotient mit 25 signifikanten Bit.
+ */
+static inline uint32_t mant_div(uint32_t mant_a, uint32_t mant_b, uint32_t *sticky)
+{
+#ifdef FLOAT_DIV_NEWTON
+    // Divisor als b * 2^31 mit b in [1, 2), Kehrwert als x * 2^31 mit x in (0.5, 1]
+    uint32_t nb = mant_b << 8;
+    uint32_t x = (256 + recip_seed[(nb >> 25) & 0x3F]) << 22;
+
+    // x = x * (2 - b * x), b * x als Q2.30
+    x = mul32_hi(x, 0x80000000 - mul32_hi(nb, x)) << 2;
+    x = mul32_hi(x, 0x80000000 - mul32_hi(nb, x)) << 2;
+
+    // a * x als Q.30, davon 25 Bit; ein Bit mehr bei a >= 2b
+    uint32_t na = mant_a << 7;
+    uint32_t q = mul32_hi(na, x) >> 5;
+
+    // Rest modulo 2^32, der Fehler von q liegt bei wenigen Einheiten
+    int32_t rem = (int32_t)((mant_a << 24) - q * mant_b);
+    while (rem < 0)
+    {
+        q--;
+        rem += (int32_t)mant_b;
+    }
+    while ((uint32_t)rem >= mant_b)
+    {
+        q++;
+        rem -= (int32_t)mant_b;
+    }
+    *sticky = (rem != 0);
+    return q;
+#else
+    uint32_t rem = mant_a;
+    uint32_t q = 0;
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        q <<= 1;
+        if (rem >= mant_b)
+        {
+            rem -= mant_b;
+            q |= 1;
+        }
+        rem <<= 1;
+    }
+    *sticky = (rem != 0);
+    return q;
+#endif
+}
+
 float __divsf3(float a, float b)
 {
     float_union ua = {.f = a};
@@ -463,6 +640,8 @@ float __divsf3(float a, float b)
     {
         if (FLOAT_MANT(ua.i))
             return a;
+        if (FLOAT_EXP(ub.i) == 0xFF && FLOAT_MANT(ub.i))
+            return b;
         if (FLOAT_EXP(ub.i) == 0xFF && (FLOAT_MANT(ub.i) == 0))
         {
             float_union res;
@@ -502,50 +681,76 @@ float __divsf3(float a, float b)
     }
 
     int sign = FLOAT_SIGN(ua.i) ^ FLOAT_SIGN(ub.i);
-    int exp_a = (FLOAT_EXP(ua.i) == 0 ? 1 - FLOAT_BIAS : FLOAT_EXP(ua.i));
-    int exp_b = (FLOAT_EXP(ub.i) == 0 ? 1 - FLOAT_BIAS : FLOAT_EXP(ub.i));
-    uint32_t mant_a = (FLOAT_EXP(ua.i) == 0 ? FLOAT_MANT(ua.i) : (FLOAT_MANT(ua.i) | (1u << 23)));
-    uint32_t mant_b = (FLOAT_EXP(ub.i) == 0 ? FLOAT_MANT(ub.i) : (FLOAT_MANT(ub.i) | (1u << 23)));
-
-    uint64_t dividend = (uint64_t)mant_a << 31;
-    uint32_t divisor = mant_b;
-    uint64_t quotient = dividend / divisor;
+    int exp_a = FLOAT_EXP(ua.i);
+    int exp_b = FLOAT_EXP(ub.i);
+    uint32_t mant_a = FLOAT_MANT(ua.i);
+    uint32_t mant_b = FLOAT_MANT(ub.i);
 
-    uint32_t q = quotient >> 8;
-    uint32_t round_bit = (quotient >> 7) & 1;
-    uint32_t sticky = ((quotient & 0x7F) != 0);
-    if (round_bit && (sticky || (q & 1)))
+    // Subnormale Operanden normalisieren
+    if (exp_a == 0)
     {
-        q++;
-        if (q == (1u << 24))
+        exp_a = 1;
+        while (!(mant_a & (1u << 23)))
         {
-            q >>= 1;
-            exp_a++;
+            mant_a <<= 1;
+            exp_a--;
         }
     }
-    int exp_result = exp_a - exp_b + FLOAT_BIAS;
-    if (q & (1u << 24))
+    else
+        mant_a |= (1u << 23);
+    if (exp_b == 0)
     {
-        q >>= 1;
-        exp_result++;
+        exp_b = 1;
+        while (!(mant_b & (1u << 23)))
+        {
+            mant_b <<= 1;
+            exp_b--;
+        }
     }
-    if (exp_result <= 0)
+    else
+        mant_b |= (1u << 23);
+
+    int exp_result = exp_a - exp_b + FLOAT_BIAS;
+    if (mant_a < mant_b)
     {
-        int shift = 1 - exp_result;
-        if (shift < 32)
-            q >>= shift;
-        else
-            q = 0;
-        exp_result = 0;
+        mant_a <<= 1;
+        exp_result--;
     }
+
+    // 24 Bit Mantisse + Rundungsbit, Rest als Sticky-Bit
+    uint32_t sticky;
+    uint32_t q = mant_div(mant_a, mant_b, &sticky);
+
     if (exp_result >= 255)
     {
         float_union res;
         res.i = (sign << 31) | (0xFF << 23);
         return res.f;
     }
+
+    if (exp_result <= 0)
+    {
+        uint32_t shift = 1 - exp_result;
+        if (shift > 26)
+            shift = 26;
+        sticky |= ((q & ((1u << shift) - 1)) != 0);
+        q >>= shift;
+        exp_result = 0;
+    }
+
+    uint32_t mant = q >> 1;
+    if ((q & 1) && (sticky || (mant & 1)))
+    {
+        mant++;
+    }
+
+    // Normale Ergebnisse: Die führende 1 erhöht den Exponenten um eins,
+    // ein Rundungsübertrag ebenso. Subnormale gehen so nahtlos in normale über.
     float_union res;
-    res.i = (sign << 31) | ((exp_result & 0xFF) << 23) | (q & 0x7FFFFF);
+    if (exp_result == 0)
+        res.i = (sign << 31) | mant;
+    else
+        res.i = ((sign << 31) | ((exp_result - 1) << 23)) + mant;
     return res.f;
 }
 
@@ -559,21 +764,82 @@ int32_t __ltsf2(float a, float b)
     return (a < b) ? 1 : 0;
 }
 
-uint32_t __clzsi2(uint32_t x)
+/**
+ * @brief Anzahl führender Nullbits, per Binärsuche in fünf Schritten.
+ */
+static inline uint32_t nlz32(uint32_t x)
 {
-    uint32_t count = 0;
+    uint32_t n = 0;
+
     if (x == 0)
     {
         return 32;
     }
-    while (!(x & 0x80000000))
+    if (!(x & 0xFFFF0000))
+    {
+        n += 16;
+        x <<= 16;
+    }
+    if (!(x & 0xFF000000))
+    {
+        n += 8;
+        x <<= 8;
+    }
+    if (!(x & 0xF0000000))
+    {
+        n += 4;
+        x <<= 4;
+    }
+    if (!(x & 0xC0000000))
     {
-        count++;
-        x <<= 1;
+        n += 2;
+        x <<= 2;
     }
-    return count;
+    if (!(x & 0x80000000))
+    {
+        n += 1;
+    }
+    return n;
 }
 
+uint32_t __clzsi2(uint32_t x)
+{
+    return nlz32(x);
+}
+
+#ifdef HARDWAREDIVISION
+/**
+ * @brief Berechnet kurze Divisionen ohne den Hardware-Divider.
+ *
+ * Der Divider benötigt 2 + ceil(q / 2) Takte für q = nlz(d) - nlz(n) + 1
+ * Quotientenbits. Bei höchstens einem Quotientenbit (n < 2d) sind das nur
+ * 2 bis 3 Takte, die Buszugriffe auf den Divider kosten dann mehr als ein
+ * Vergleich mit Subtraktion in Software.
+ *
+ * @return 1, wenn Quotient und Rest berechnet wurden, sonst 0.
+ */
+static inline uint32_t div_short(uint32_t n, uint32_t d, uint32_t *quo, uint32_t *rem)
+{
+    if (d == 0)
+    {
+        return 0;
+    }
+    if (n < d)
+    {
+        *quo = 0;
+        *rem = n;
+        return 1;
+    }
+    if (n - d < d)
+    {
+        *quo = 1;
+        *rem = n - d;
+        return 1;
+    }
+    return 0;
+}
+#endif
+
 uint32_t __ffssi2(uint32_t x)
 {
     if (x == 0)
@@ -589,6 +855,98 @@ typedef struct
     uint32_t remainder;
 } divmod_result;
 
+#ifndef HARDWAREDIVISION
+/**
+ * @brief Sonderfälle für Divisoren unter 16: d = ungerader Anteil * 2^shift,
+ *        gespeichert als (Anteil << 4) | shift. 0 heißt kein Sonderfall.
+ */
+static const uint8_t small_div[16] = {
+    0x00, 0x10, 0x11, 0x30, 0x12, 0x50, 0x31, 0x00,
+    0x13, 0x00, 0x51, 0x00, 0x32, 0x00, 0x00, 0x00,
+};
+
+/**
+ * @brief n / 3 über den Kehrwert 0.0101...b als Shift-Add-Folge. Die Schätzung
+ *        ist um höchstens 5 zu klein und wird über den Rest korrigiert.
+ */
+static inline uint32_t divu3(uint32_t n, uint32_t *rem)
+{
+    uint32_t q = (n >> 2) + (n >> 4);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    uint32_t r = n - ((q << 1) + q);
+    uint32_t c = ((r << 3) + (r << 1) + r) >> 5;
+    *rem = r - ((c << 1) + c);
+    return q + c;
+}
+
+/**
+ * @brief n / 5 über den Kehrwert 0.00110011...b als Shift-Add-Folge. Die Schätzung
+ *        ist um höchstens 5 zu klein und wird über den Rest korrigiert.
+ */
+static inline uint32_t divu5(uint32_t n, uint32_t *rem)
+{
+    uint32_t q = (n >> 3) + (n >> 4);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    uint32_t r = n - ((q << 2) + q);
+    uint32_t c = ((r << 3) + (r << 2) + r) >> 6;
+    *rem = r - ((c << 2) + c);
+    return q + c;
+}
+
+/**
+ * @brief Software-Division mit Rest, divisor ungleich 0.
+ *
+ * Zweierpotenzen werden geschoben, Divisoren aus small_div über divu3/divu5
+ * geteilt. Sonst wird der Divisor per führender Nullbits (wie __clzsi2) auf
+ * die oberste Stelle des Dividenden ausgerichtet, sodass die Schleife nur
+ * über die signifikanten Quotientenbits läuft statt immer über 32.
+ */
+static inline uint32_t udivmod32(uint32_t n, uint32_t d, uint32_t *rem)
+{
+    uint32_t q = 0;
+
+    if (n < d)
+    {
+        *rem = n;
+        return 0;
+    }
+
+    if ((d & (d - 1)) == 0)
+    {
+        *rem = n & (d - 1);
+        return n >> (31 - nlz32(d));
+    }
+
+    if (d < 16 && small_div[d])
+    {
+        uint32_t shift = small_div[d] & 0x0F;
+        uint32_t r;
+        q = ((small_div[d] >> 4) == 3) ? divu3(n >> shift, &r) : divu5(n >> shift, &r);
+        *rem = (r << shift) | (n & ((1U << shift) - 1));
+        return q;
+    }
+
+    uint32_t steps = nlz32(d) - nlz32(n);
+    d <<= steps;
+    for (uint32_t i = 0; i <= steps; i++)
+    {
+        q <<= 1;
+        if (n >= d)
+        {
+            n -= d;
+            q |= 1;
+        }
+        d >>= 1;
+    }
+    *rem = n;
+    return q;
+}
+#endif
+
 divmod_result __divmodsi4(uint32_t dividend, uint32_t divisor) {
     divmod_result res = {0, 0};
 
@@ -601,90 +959,187 @@ divmod_result __divmodsi4(uint32_t dividend, uint32_t divisor) {
         res.remainder = div_get_remainder();
     }
 #else
-    if (divisor == 0) {
-        res.quotient = 0;
-        res.remainder = 0;
-    } else {
-        uint32_t temp = 0;
-        for (int32_t i = 31; i >= 0; i--) {
-            temp = (temp << 1) | ((dividend >> i) & 1);
-            if (temp >= divisor) {
-                temp -= divisor;
-                res.quotient |= (1U << i);
-            }
-        }
-        res.remainder = temp;
+    if (divisor != 0) {
+        res.quotient = udivmod32(dividend, divisor, &res.remainder);
     }
 #endif
 
     return res;
 }
 
+/**
+ * @brief Untere 64 Bit des Produkts zweier 64-Bit-Werte, für vorzeichenlose
+ *        und vorzeichenbehaftete Operanden gleich.
+ *
+ * Die Kreuzprodukte tragen nur zu den oberen 32 Bit bei und werden nur
+ * berechnet, wenn ein Operand nicht in 32 Bit passt.
+ */
+static inline uint64_t mul_64x64(uint64_t a, uint64_t b)
+{
+    uint32_t a_lo = (uint32_t)a;
+    uint32_t a_hi = (uint32_t)(a >> 32);
+    uint32_t b_lo = (uint32_t)b;
+    uint32_t b_hi = (uint32_t)(b >> 32);
+    uint64_t result = umul_32x32(a_lo, b_lo);
+    uint32_t cross = 0;
+
+    if (a_hi)
+    {
+        cross += b_lo * a_hi;
+    }
+    if (b_hi)
+    {
+        cross += a_lo * b_hi;
+    }
+    return result + ((uint64_t)cross << 32);
+}
+
 int64_t __muldi3(int64_t a, int64_t b)
 {
-    uint64_t ua, ub, result = 0;
-    int negative = 0;
+    return (int64_t)mul_64x64((uint64_t)a, (uint64_t)b);
+}
 
-    ua = (uint64_t)a;
-    if (a < 0)
+/**
+ * @brief Teilt (u1 * 2^32 + u0) durch v mit 32-Bit-Quotient, Voraussetzung u1 < v.
+ *
+ * Normalisierte Langdivision nach Knuth (Algorithmus D) mit 16-Bit-Ziffern:
+ * v wird so verschoben, dass das oberste Bit gesetzt ist. Dann liefert je eine
+ * 32/16-Bit-Division eine Quotientenziffer, die höchstens zweimal korrigiert wird.
+ *
+ * @param rem Erhält den Rest.
+ * @return Quotient.
+ */
+static uint32_t divlu(uint32_t u1, uint32_t u0, uint32_t v, uint32_t *rem)
+{
+    uint32_t s = nlz32(v);
+    uint32_t vn1, vn0, un32, un21, un10, un1, un0, q1, q0, rhat;
+
+    v <<= s;
+    vn1 = v >> 16;
+    vn0 = v & 0xFFFF;
+    un32 = s ? (u1 << s) | (u0 >> (32 - s)) : u1;
+    un10 = u0 << s;
+    un1 = un10 >> 16;
+    un0 = un10 & 0xFFFF;
+
+    q1 = un32 / vn1;
+    rhat = un32 - vn1 * q1;
+    while (q1 > 0xFFFF || vn0 * q1 > ((rhat << 16) | un1))
+    {
+        q1--;
+        rhat += vn1;
+        if (rhat > 0xFFFF)
+        {
+            break;
+        }
+    }
+
+    // Rechnung modulo 2^32, das Ergebnis ist kleiner als v
+    un21 = (un32 << 16) + un1 - v * q1;
+
+    q0 = un21 / vn1;
+    rhat = un21 - vn1 * q0;
+    while (q0 > 0xFFFF || vn0 * q0 > ((rhat << 16) | un0))
     {
-        negative = !negative;
-        ua = (~ua) + 1;
+        q0--;
+        rhat += vn1;
+        if (rhat > 0xFFFF)
+        {
+            break;
+        }
     }
 
-    ub = (uint64_t)b;
-    if (b < 0)
+    *rem = ((un21 << 16) + un0 - v * q0) >> s;
+    return (q1 << 16) | q0;
+}
+
+/**
+ * @brief Vorzeichenlose 64-Bit-Division mit Rest, divisor ungleich 0.
+ *
+ * Passen beide Operanden in 32 Bit, reicht __divmodsi4. Bei 32-Bit-Divisor wird
+ * der obere Teil des Dividenden einzeln geteilt und der Rest mit divlu weiter-
+ * verarbeitet. Bei größerem Divisor passt der Quotient in 32 Bit und wird aus
+ * den normalisierten oberen 32 Bit des Divisors geschätzt und über den Rest um
+ * höchstens eins korrigiert.
+ */
+static uint64_t udivmod64(uint64_t dividend, uint64_t divisor, uint64_t *rem)
+{
+    uint32_t n_hi = (uint32_t)(dividend >> 32);
+    uint32_t n_lo = (uint32_t)dividend;
+    uint32_t d_hi = (uint32_t)(divisor >> 32);
+    uint32_t d_lo = (uint32_t)divisor;
+    uint32_t q_hi = 0;
+    uint32_t q_lo;
+    uint32_t r;
+
+    if (d_hi == 0)
     {
-        negative = !negative;
-        ub = (~ub) + 1;
+        if (n_hi == 0)
+        {
+            divmod_result res = __divmodsi4(n_lo, d_lo);
+            *rem = res.remainder;
+            return res.quotient;
+        }
+
+        r = n_hi;
+        if (n_hi >= d_lo)
+        {
+            divmod_result res = __divmodsi4(n_hi, d_lo);
+            q_hi = res.quotient;
+            r = res.remainder;
+        }
+        q_lo = divlu(r, n_lo, d_lo, &r);
+        *rem = r;
+        return ((uint64_t)q_hi << 32) | q_lo;
     }
 
-    while (ub)
+    if (dividend < divisor)
     {
-        if (ub & 1)
-            result += ua;
-        ua <<= 1;
-        ub >>= 1;
+        *rem = dividend;
+        return 0;
     }
 
-    if (negative)
-        result = (~result) + 1;
+    // Quotient aus (dividend / 2) / (obere 32 Bit des normalisierten Divisors)
+    uint32_t s = nlz32(d_hi);
+    uint32_t v1 = s ? (d_hi << s) | (d_lo >> (32 - s)) : d_hi;
+    uint32_t q = divlu(n_hi >> 1, (n_lo >> 1) | (n_hi << 31), v1, &r) >> (31 - s);
+    uint64_t rest;
 
-    return (int64_t)result;
+    if (q != 0)
+    {
+        q--;
+    }
+    rest = dividend - (umul_32x32(q, d_lo) + ((uint64_t)(d_hi * q) << 32));
+    if (rest >= divisor)
+    {
+        q++;
+        rest -= divisor;
+    }
+    *rem = rest;
+    return q;
 }
 
 uint64_t __udivdi3(uint64_t dividend, uint64_t divisor)
 {
+    uint64_t rem;
+
     if (divisor == 0)
     {
         return ~((uint64_t)0);
     }
-    uint64_t quotient = 0;
-    for (int32_t i = 63; i >= 0; i--)
-    {
-        if ((dividend >> i) >= divisor)
-        {
-            quotient |= ((uint64_t)1 << i);
-            dividend -= (divisor << i);
-        }
-    }
-    return quotient;
+    return udivmod64(dividend, divisor, &rem);
 }
 
 uint64_t __umoddi3(uint64_t dividend, uint64_t divisor)
 {
+    uint64_t rem;
+
     if (divisor == 0)
     {
         return 0;
     }
-    for (int32_t i = 63; i >= 0; i--)
-    {
-        if ((dividend >> i) >= divisor)
-        {
-            dividend -= (divisor << i);
-        }
-    }
-    return dividend;
+    udivmod64(dividend, divisor, &rem);
+    return rem;
 }
 
 int64_t __divdi3(int64_t dividend, int64_t divisor)
@@ -808,8 +1263,17 @@ uint64_t __lshrdi3(uint64_t a, int32_t b)
 uint32_t __mulsi3(uint32_t a, uint32_t b)
 {
 #ifdef HARDWAREDIVISION
-    return mult_calc_32(a, b);
-#else
+    if (a < b)
+    {
+        uint32_t tmp = a;
+        a = b;
+        b = tmp;
+    }
+    if (b >= mult_get_sw_limit())
+    {
+        return mult_calc_32(a, b);
+    }
+#endif
     uint32_t result = 0;
     while (b)
     {
@@ -821,12 +1285,16 @@ uint32_t __mulsi3(uint32_t a, uint32_t b)
         b >>= 1;
     }
     return result;
-#endif
 }
 
 uint32_t __udivsi3(uint32_t dividend, uint32_t divisor)
 {
 #ifdef HARDWAREDIVISION
+    uint32_t quo, rem;
+    if (div_short(dividend, divisor, &quo, &rem))
+    {
+        return quo;
+    }
     return div_calc_quotient(dividend, divisor);
 #else
     if (divisor == 0)
@@ -834,22 +1302,19 @@ uint32_t __udivsi3(uint32_t dividend, uint32_t divisor)
         return 0;
     }
 
-    uint32_t quotient = 0, temp = 0;
-    for (int32_t i = 31; i >= 0; i--)
-    {
-        temp = (temp << 1) | ((dividend >> i) & 1);
-        if (temp >= divisor) {
-            temp -= divisor;
-            quotient |= (1U << i);
-        }
-    }
-    return quotient;
+    uint32_t remainder;
+    return udivmod32(dividend, divisor, &remainder);
 #endif
 }
 
 uint32_t __umodsi3(uint32_t dividend, uint32_t divisor)
 {
 #ifdef HARDWAREDIVISION
+    uint32_t quo, rem;
+    if (div_short(dividend, divisor, &quo, &rem))
+    {
+        return rem;
+    }
     return div_calc_remainder(dividend, divisor);
 #else
     if (divisor == 0)
@@ -857,16 +1322,9 @@ uint32_t __umodsi3(uint32_t dividend, uint32_t divisor)
         return 0;
     }
 
-    uint32_t temp = 0;
-    for (int32_t i = 31; i >= 0; i--)
-    {
-        temp = (temp << 1) | ((dividend >> i) & 1);
-        if (temp >= divisor)
-        {
-            temp -= divisor;
-        }
-    }
-    return temp;
+    uint32_t remainder;
+    udivmod32(dividend, divisor, &remainder);
+    return remainder;
 #endif
 }
 
@@ -875,8 +1333,12 @@ int32_t __divsi3(int32_t dividend, int32_t divisor)
 #ifdef HARDWAREDIVISION
     uint32_t abs_dividend = (dividend < 0) ? -dividend : dividend;
     uint32_t abs_divisor = (divisor < 0) ? -divisor : divisor;
-    uint32_t result = div_calc_quotient(abs_dividend, abs_divisor);
-    return ((dividend < 0) ^ (divisor < 0)) ? -(int32_t)result : (int32_t)result;
+    uint32_t quo, rem;
+    if (div_short(abs_dividend, abs_divisor, &quo, &rem))
+    {
+        return ((dividend < 0) ^ (divisor < 0)) ? -(int32_t)quo : (int32_t)quo;
+    }
+    return div_calc_signed_quotient(dividend, divisor);
 #else
     if (divisor == 0)
     {
@@ -885,17 +1347,8 @@ int32_t __divsi3(int32_t dividend, int32_t divisor)
 
     uint32_t abs_dividend = (dividend < 0) ? -dividend : dividend;
     uint32_t abs_divisor = (divisor < 0) ? -divisor : divisor;
-    uint32_t quotient = 0, temp = 0;
-
-    for (int32_t i = 31; i >= 0; i--)
-    {
-        temp = (temp << 1) | ((abs_dividend >> i) & 1);
-        if (temp >= abs_divisor)
-        {
-            temp -= abs_divisor;
-            quotient |= (1U << i);
-        }
-    }
+    uint32_t temp;
+    uint32_t quotient = udivmod32(abs_dividend, abs_divisor, &temp);
 
     return ((dividend < 0) ^ (divisor < 0)) ? -(int32_t)quotient : (int32_t)quotient;
 #endif
@@ -906,8 +1359,12 @@ int32_t __modsi3(int32_t dividend, int32_t divisor)
 #ifdef HARDWAREDIVISION
     uint32_t abs_dividend = (dividend < 0) ? -dividend : dividend;
     uint32_t abs_divisor = (divisor < 0) ? -divisor : divisor;
-    uint32_t result = div_calc_remainder(abs_dividend, abs_divisor);
-    return (dividend < 0) ? -(int32_t)result : (int32_t)result;
+    uint32_t quo, rem;
+    if (div_short(abs_dividend, abs_divisor, &quo, &rem))
+    {
+        return (dividend < 0) ? -(int32_t)rem : (int32_t)rem;
+    }
+    return div_calc_signed_remainder(dividend, divisor);
 #else
     if (divisor == 0)
     {
@@ -916,16 +1373,8 @@ int32_t __modsi3(int32_t dividend, int32_t divisor)
 
     uint32_t abs_dividend = (dividend < 0) ? -dividend : dividend;
     uint32_t abs_divisor = (divisor < 0) ? -divisor : divisor;
-    uint32_t temp = 0;
-
-    for (int32_t i = 31; i >= 0; i--)
-    {
-        temp = (temp << 1) | ((abs_dividend >> i) & 1);
-        if (temp >= abs_divisor)
-        {
-            temp -= abs_divisor;
-        }
-    }
+    uint32_t temp;
+    udivmod32(abs_dividend, abs_divisor, &temp);
 
     return (dividend < 0) ? -(int32_t)temp : (int32_t)temp;
 #endif
@@ -983,27 +1432,5 @@ uint32_t __fixunssfsi(float x)
 
 uint64_t __umuldi3(uint64_t a, uint64_t b)
 {
-#ifdef HARDWAREDIVISION
-    uint32_t a_low   = (uint32_t)(a & 0xFFFFFFFF);
-    uint32_t a_high  = (uint32_t)(a >> 32);
-    uint32_t b_low   = (uint32_t)(b & 0xFFFFFFFF);
-    uint32_t b_high  = (uint32_t)(b >> 32);
-    uint64_t low_low = mult_calc_64(a_low, b_low);
-    uint64_t cross1  = mult_calc_64(a_low, b_high);
-    uint64_t cross2  = mult_calc_64(a_high, b_low);
-    uint64_t cross   = cross1 + cross2;
-    return   low_low + (cross << 32);
-#else
-    uint64_t result = 0;
-    while (b)
-    {
-        if (b & 1)
-        {
-            result += a;
-        }
-        a <<= 1;
-        b >>= 1;
-    }
-    return result;
-#endif
+    return mul_64x64(a, b);
 }
\ No newline at end of file
@@ -2,8 +2,57 @@
 .global _start
 .global _estack
 
+    .equ STACK_CANARY, 0xDEADBEEF   # Muss zu STACK_CANARY in wgrhal_ext.h passen
+
 _start:
     la sp, _estack
+
+    # .data vom Ladeort kopieren, entfällt wenn Lade- und Laufzeitadresse gleich sind
+    la t0, _sidata
+    la t1, _sdata
+    la t2, _edata
+    beq t0, t1, data_done
+    beq t1, t2, data_done
+copy_data:
+    lw a0, 0(t0)
+    addi t0, t0, 4
+    sw a0, 0(t1)
+    addi t1, t1, 4
+    bltu t1, t2, copy_data
+data_done:
+
+    # .bss nullen, vier Wörter pro Durchlauf, danach der Rest wortweise
+    la t0, _sbss
+    la t1, _ebss
+    sub t2, t1, t0
+    andi t2, t2, -16
+    add t2, t0, t2
+    beq t0, t2, zero_words
+zero_block:
+    sw zero, 0(t0)
+    sw zero, 4(t0)
+    sw zero, 8(t0)
+    sw zero, 12(t0)
+    addi t0, t0, 16
+    bne t0, t2, zero_block
+zero_words:
+    beq t0, t1, bss_done
+zero_word:
+    sw zero, 0(t0)
+    addi t0, t0, 4
+    bne t0, t1, zero_word
+bss_done:
+
+    # Stack mit STACK_CANARY füllen, stack_high_water() sucht das erste überschriebene Wort
+    la t0, _sstack
+    li t1, STACK_CANARY
+paint_stack:
+    bgeu t0, sp, paint_done
+    sw t1, 0(t0)
+    addi t0, t0, 4
+    j paint_stack
+paint_done:
+
     jal ra, main
 
 infinite_loop:
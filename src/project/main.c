@@ -8,6 +8,7 @@ uint32_t cursor = 0;
 uint32_t current_note = 0;
 uint32_t current_octave = 0;
 uint32_t last_housekeep = 0;
+const udiv_const_t ms_per_sec = UDIV_CONST(1000);
 
 const char *skip_spaces(const char *str)
 {
@@ -55,6 +56,7 @@ void print_help(void)
 
     terminal_print("\ntime [-ms]");
     terminal_print("\nheap");
+    terminal_print("\nstack");
 
     terminal_print("\nnote <note> <oct>");
     terminal_print("\nnote [-off]");
@@ -281,9 +283,18 @@ int32_t interpret_cmd()
     }
     else if (strncmp(buffer, "heap", strlen("heap")) == 0)
     {
-        uint32_t free_space = heap_free_space();
-        print_ok_res("Free: ", free_space);
-        print_ok("MB");
+        heap_stats_t stats;
+        heap_get_stats(&stats);
+        print_ok_res("Free: ", stats.free_bytes);
+        print_ok_res("Largest: ", stats.largest_free);
+        print_ok_res("Blocks: ", stats.free_blocks);
+        print_ok_res("Peak: ", stats.peak_used);
+        print_ok_res("Fails: ", stats.fail_count);
+    }
+    else if (strncmp(buffer, "stack", strlen("stack")) == 0)
+    {
+        print_ok_res("Stack max: ", stack_high_water());
+        print_ok_res("Size: ", stack_size());
     }
     else if (strncmp(buffer, "time", strlen("time")) == 0)
     {
@@ -295,7 +306,7 @@ int32_t interpret_cmd()
         }
         else
         {
-            print_ok_res("TIME: ", (int32_t)(millis() / 1000));
+            print_ok_res("TIME: ", (int32_t)udiv_const_div(millis(), &ms_per_sec));
             print_ok("s");
         }
     }
@@ -1,8 +1,26 @@
 #include "wgrhal.h"
+#include "wgrhal_ext.h"
+#include "wgrfix.h"
 
 #define ITER_GENERAL 8
 #define ITER_SOFTLIB 1
 #define ARRAY_SIZE 64
+#define MEM_BENCH_SIZE 256
+
+static uint8_t __attribute__((aligned(4))) mem_bench_src[MEM_BENCH_SIZE + 8];
+static uint8_t __attribute__((aligned(4))) mem_bench_dst[MEM_BENCH_SIZE + 8];
+
+#define SPI_BENCH_SIZE 64
+
+static uint8_t __attribute__((aligned(4))) spi_bench_buf[SPI_BENCH_SIZE];
+
+#define STR_BENCH_LEN 64
+
+static char __attribute__((aligned(4))) str_bench_a[STR_BENCH_LEN + 1] =
+    "help mult div invert clear scroll time heap note ws pin spibaud!";
+static char __attribute__((aligned(4))) str_bench_b[STR_BENCH_LEN + 1] =
+    "help mult div invert clear scroll time heap note ws pin spibaud!";
+static char __attribute__((aligned(4))) str_bench_dst[STR_BENCH_LEN + 8];
 
 uint32_t conv_time(uint32_t benchmark_iter_time, uint32_t iterations)
 {
@@ -102,6 +120,82 @@ uint32_t benchmark_malloc_free() {
     return end - start;
 }
 
+#define MALLOC_BENCH_LIVE 16
+
+// Viele lebende Blöcke unterschiedlicher Größe, jeder zweite wird neu angelegt
+uint32_t benchmark_malloc_free_mixed() {
+    void *live[MALLOC_BENCH_LIVE];
+    for (uint32_t i = 0; i < MALLOC_BENCH_LIVE; i++) {
+        live[i] = malloc(8 + (i & 7) * 12);
+    }
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < ITER_GENERAL; i++) {
+        uint32_t slot = (i * 2) & (MALLOC_BENCH_LIVE - 1);
+        free(live[slot]);
+        live[slot] = malloc(8 + ((i + slot) & 7) * 12);
+    }
+    uint32_t end = micros();
+    for (uint32_t i = 0; i < MALLOC_BENCH_LIVE; i++) {
+        free(live[i]);
+    }
+    return end - start;
+}
+
+#define REALLOC_BENCH_STEP 16
+#define REALLOC_BENCH_MAX 128
+
+// Wachsender Puffer wie der Textpuffer der Shell, pro Iteration 8 realloc
+uint32_t benchmark_realloc_grow() {
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < ITER_GENERAL; i++) {
+        char *buf = (char*)malloc(REALLOC_BENCH_STEP);
+        for (uint32_t size = 2 * REALLOC_BENCH_STEP; size <= REALLOC_BENCH_MAX; size += REALLOC_BENCH_STEP) {
+            buf = (char*)realloc(buf, size);
+            buf[size - 1] = (char)i;
+        }
+        buf = (char*)realloc(buf, REALLOC_BENCH_STEP);
+        free(buf);
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_calloc() {
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < ITER_GENERAL; i++) {
+        free(calloc(REALLOC_BENCH_MAX / sizeof(uint32_t), sizeof(uint32_t)));
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
+static pool_t bench_pool;
+
+uint32_t benchmark_pool_alloc_free() {
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < ITER_GENERAL; i++) {
+        volatile uint32_t* ptr = (uint32_t*)pool_alloc(&bench_pool);
+        *ptr = i;
+        pool_free(&bench_pool, (void*)ptr);
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
+static arena_t bench_arena;
+
+uint32_t benchmark_arena_alloc_reset() {
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < ITER_GENERAL; i++) {
+        uint32_t mark = arena_mark(&bench_arena);
+        volatile uint32_t* ptr = (uint32_t*)arena_alloc(&bench_arena, sizeof(uint32_t), 0);
+        *ptr = i;
+        arena_reset(&bench_arena, mark);
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
 uint32_t benchmark_16bit_addition() {
     volatile uint16_t a = 1000, b = 2000, result = 0;
     uint32_t start = micros();
@@ -206,6 +300,117 @@ uint32_t benchmark_integer_division()
     return end - start;
 }
 
+// Divisor ohne Sonderfall: Schleife nur über die signifikanten Quotientenbits
+uint32_t benchmark_integer_division_7()
+{
+    volatile uint32_t a = 1000000;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < ITER_SOFTLIB; i++)
+    {
+        a /= 7;
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
+// Division durch feste Divisoren: __udivsi3 gegen vorberechneten Kehrwert
+#define UDIV_BENCH_ITER 16
+
+static const udiv_const_t udiv_bench_10 = UDIV_CONST(10);
+static const udiv_const_t udiv_bench_247 = UDIV_CONST(247);
+static const udiv_const_t udiv_bench_1000 = UDIV_CONST(1000);
+
+uint32_t benchmark_udivsi3(uint32_t divisor)
+{
+    volatile uint32_t n = 12000000;
+    volatile uint32_t d = divisor;
+    volatile uint32_t r;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < UDIV_BENCH_ITER; i++)
+    {
+        r = n / d;
+    }
+    uint32_t end = micros();
+    (void)r;
+    return end - start;
+}
+
+uint32_t benchmark_udiv_const(const udiv_const_t *d)
+{
+    volatile uint32_t n = 12000000;
+    volatile uint32_t r;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < UDIV_BENCH_ITER; i++)
+    {
+        r = udiv_const_div(n, d);
+    }
+    uint32_t end = micros();
+    (void)r;
+    return end - start;
+}
+
+// Hardware-Multiplikation/-Division: blockierende Aufrufe gegen verzahnte Arrays
+#define HWOP_BENCH_SIZE 16
+
+static uint32_t hwop_a[HWOP_BENCH_SIZE];
+static uint32_t hwop_b[HWOP_BENCH_SIZE];
+static uint32_t hwop_out[HWOP_BENCH_SIZE];
+static uint32_t hwop_rem[HWOP_BENCH_SIZE];
+
+static void hwop_fill()
+{
+    for (uint32_t i = 0; i < HWOP_BENCH_SIZE; i++)
+    {
+        hwop_a[i] = 0x12345678 ^ (i << 20);
+        hwop_b[i] = (i << 4) + 3;
+    }
+}
+
+uint32_t benchmark_mult_blocking()
+{
+    hwop_fill();
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < HWOP_BENCH_SIZE; i++)
+    {
+        hwop_out[i] = mult_calc(hwop_a[i], hwop_b[i]);
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_mult_array()
+{
+    hwop_fill();
+    uint32_t start = micros();
+    mult_array(hwop_a, hwop_b, hwop_out, HWOP_BENCH_SIZE);
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_divmod_blocking()
+{
+    div_result_t result;
+    hwop_fill();
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < HWOP_BENCH_SIZE; i++)
+    {
+        div_calc(hwop_a[i], hwop_b[i], &result);
+        hwop_out[i] = result.quotient;
+        hwop_rem[i] = result.remainder;
+    }
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_divmod_array()
+{
+    hwop_fill();
+    uint32_t start = micros();
+    divmod_array(hwop_a, hwop_b, hwop_out, hwop_rem, HWOP_BENCH_SIZE);
+    uint32_t end = micros();
+    return end - start;
+}
+
 uint32_t benchmark_bitwise_shift()
 {
     volatile uint32_t a = 1;
@@ -232,6 +437,252 @@ uint32_t benchmark_conversion()
     return end - start;
 }
 
+// Float-Operationen pro Sekunde, das Backend (Software oder
+// Hardware-Multiplikator) wird über HARDWAREDIVISION in wgrlib.c gewählt
+#define FLOAT_BENCH_ITER 32
+
+float __addsf3(float a, float b);
+float __mulsf3(float a, float b);
+float __divsf3(float a, float b);
+
+uint32_t benchmark_float_ops(float (*op)(float, float))
+{
+    volatile float a = 1.2345f;
+    volatile float b = 0.9876f;
+    volatile float r;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < FLOAT_BENCH_ITER; i++)
+    {
+        r = op(a, b);
+    }
+    uint32_t end = micros();
+    (void)r;
+    return end - start;
+}
+
+// Festkomma (wgrfix.c) gegen Software-Float mit denselben Operanden
+#define FIX_BENCH_ITER 32
+
+float __subsf3(float a, float b);
+
+uint32_t benchmark_q16_ops(q16_t (*op)(q16_t, q16_t))
+{
+    volatile q16_t a = 80904; // 1.2345
+    volatile q16_t b = 64723; // 0.9876
+    volatile q16_t r;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < FIX_BENCH_ITER; i++)
+    {
+        r = op(a, b);
+    }
+    uint32_t end = micros();
+    (void)r;
+    return end - start;
+}
+
+uint32_t benchmark_q16_func(q16_t (*fn)(q16_t))
+{
+    volatile q16_t a = 80904; // 1.2345
+    volatile q16_t r;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < FIX_BENCH_ITER; i++)
+    {
+        r = fn(a);
+    }
+    uint32_t end = micros();
+    (void)r;
+    return end - start;
+}
+
+uint32_t benchmark_float_func(float (*fn)(float))
+{
+    volatile float a = 1.2345f;
+    volatile float r;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < FIX_BENCH_ITER; i++)
+    {
+        r = fn(a);
+    }
+    uint32_t end = micros();
+    (void)r;
+    return end - start;
+}
+
+// Float-Referenzen ohne libm: Wurzel per Newton-Verfahren, Sinus per Taylorreihe für |x| <= Pi/2
+float float_sqrt_newton(float x)
+{
+    float r = (x > 1.0f) ? x * 0.5f : 1.0f;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        r = 0.5f * (r + x / r);
+    }
+    return r;
+}
+
+float float_sin_taylor(float x)
+{
+    float x2 = x * x;
+    return x * (1.0f + x2 * (-0.16666667f + x2 * (0.0083333333f - x2 * 0.00019841270f)));
+}
+
+uint32_t ops_per_sec(uint32_t ops, uint32_t time_us)
+{
+    if (time_us == 0)
+    {
+        time_us = 1;
+    }
+    return (ops * 1000000) / time_us;
+}
+
+// Byteweise Referenz, entspricht dem bisherigen memcpy
+void *memcpy_bytewise(void *dest, const void *src, uint32_t n)
+{
+    volatile unsigned char *d = (volatile unsigned char *)dest;
+    const unsigned char *s = (const unsigned char *)src;
+    while (n--)
+    {
+        *d++ = *s++;
+    }
+    return dest;
+}
+
+uint32_t benchmark_memcpy(void *(*copy)(void *, const void *, uint32_t), uint32_t dst_off, uint32_t src_off)
+{
+    uint32_t start = micros();
+    copy(mem_bench_dst + dst_off, mem_bench_src + src_off, MEM_BENCH_SIZE);
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_memset(void *(*set)(void *, int32_t, uint32_t), uint32_t dst_off)
+{
+    uint32_t start = micros();
+    set(mem_bench_dst + dst_off, 0x5A, MEM_BENCH_SIZE);
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_memmove_overlap(uint32_t dst_off, uint32_t src_off)
+{
+    uint32_t start = micros();
+    memmove(mem_bench_dst + dst_off, mem_bench_dst + src_off, MEM_BENCH_SIZE);
+    uint32_t end = micros();
+    return end - start;
+}
+
+// Byteweise Referenzen, entsprechen den bisherigen String-Funktionen
+uint32_t strlen_bytewise(const char *s)
+{
+    uint32_t len = 0;
+    while (*s++)
+    {
+        len++;
+    }
+    return len;
+}
+
+int32_t strcmp_bytewise(const char *s1, const char *s2)
+{
+    while (*s1 && (*s1 == *s2))
+    {
+        s1++;
+        s2++;
+    }
+    return (int)((unsigned char)*s1 - (unsigned char)*s2);
+}
+
+int32_t strncmp_bytewise(const char *s1, const char *s2, uint32_t n)
+{
+    while (n && *s1 && (*s1 == *s2))
+    {
+        s1++;
+        s2++;
+        n--;
+    }
+    return n ? (int)((unsigned char)*s1 - (unsigned char)*s2) : 0;
+}
+
+char *strcpy_bytewise(char *dest, const char *src)
+{
+    volatile char *d = dest;
+    while ((*d++ = *src++))
+        ;
+    return dest;
+}
+
+uint32_t benchmark_strlen(uint32_t (*len_fn)(const char *))
+{
+    volatile uint32_t len;
+    uint32_t start = micros();
+    len = len_fn(str_bench_a);
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_strcmp(int32_t (*cmp_fn)(const char *, const char *), const char *other)
+{
+    volatile int32_t res;
+    uint32_t start = micros();
+    res = cmp_fn(str_bench_a, other);
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_strncmp(int32_t (*cmp_fn)(const char *, const char *, uint32_t))
+{
+    volatile int32_t res;
+    uint32_t start = micros();
+    res = cmp_fn(str_bench_a, str_bench_b, STR_BENCH_LEN);
+    uint32_t end = micros();
+    return end - start;
+}
+
+uint32_t benchmark_strcpy(char *(*cpy_fn)(char *, const char *), uint32_t dst_off)
+{
+    uint32_t start = micros();
+    cpy_fn(str_bench_dst + dst_off, str_bench_a);
+    uint32_t end = micros();
+    return end - start;
+}
+
+// Byteweise Referenz, entspricht dem bisherigen spi_read_buffer
+int32_t spi_read_bytewise(uint8_t *buf, uint32_t length, uint32_t timeout_ms)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        int32_t ret = spi_read_byte(&buf[i], timeout_ms);
+        if (ret < 0)
+        {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+uint32_t benchmark_spi_read(int32_t (*read_fn)(uint8_t *, uint32_t, uint32_t))
+{
+    uint32_t start = micros();
+    read_fn(spi_bench_buf, SPI_BENCH_SIZE, DEFAULT_TIMEOUT);
+    uint32_t end = micros();
+    return end - start;
+}
+
+// Kosten in 1/100 µs pro Byte
+uint32_t us_per_byte(uint32_t time_us, uint32_t bytes)
+{
+    return (time_us * 100) / bytes;
+}
+
+// Durchsatz in 1/100 Byte pro µs
+uint32_t bytes_per_us(uint32_t bytes, uint32_t time_us)
+{
+    if (time_us == 0)
+    {
+        time_us = 1;
+    }
+    return (bytes * 100) / time_us;
+}
+
 int main()
 {
     // 10MHz Results
@@ -251,6 +702,13 @@ int main()
     //   2µs
     debug_write(conv_time(benchmark_malloc_free(), ITER_GENERAL));
     //  63µs
+    debug_write(conv_time(benchmark_malloc_free_mixed(), ITER_GENERAL));
+    debug_write(conv_time(benchmark_realloc_grow(), ITER_GENERAL));
+    debug_write(conv_time(benchmark_calloc(), ITER_GENERAL));
+    pool_init(&bench_pool, sizeof(uint32_t), MALLOC_BENCH_LIVE);
+    debug_write(conv_time(benchmark_pool_alloc_free(), ITER_GENERAL));
+    arena_create(&bench_arena, 64);
+    debug_write(conv_time(benchmark_arena_alloc_reset(), ITER_GENERAL));
     debug_write(conv_time(benchmark_16bit_addition(), ITER_GENERAL));
     //   4µs
     debug_write(conv_time(benchmark_8bit_addition(), ITER_GENERAL));
@@ -269,9 +727,95 @@ int main()
     //   4µs
     debug_write(conv_time(benchmark_integer_division(), ITER_SOFTLIB));
     // 156µs
+    debug_write(conv_time(benchmark_integer_division_7(), ITER_SOFTLIB));
+    // Division durch 10, 247 und 1000: __udivsi3, udiv_const_div
+    debug_write(conv_time(benchmark_udivsi3(10), UDIV_BENCH_ITER));
+    debug_write(conv_time(benchmark_udiv_const(&udiv_bench_10), UDIV_BENCH_ITER));
+    debug_write(conv_time(benchmark_udivsi3(247), UDIV_BENCH_ITER));
+    debug_write(conv_time(benchmark_udiv_const(&udiv_bench_247), UDIV_BENCH_ITER));
+    debug_write(conv_time(benchmark_udivsi3(1000), UDIV_BENCH_ITER));
+    debug_write(conv_time(benchmark_udiv_const(&udiv_bench_1000), UDIV_BENCH_ITER));
+    // Hardware-Multiplikation/-Division: blockierend, mult_array/divmod_array
+    debug_write(conv_time(benchmark_mult_blocking(), HWOP_BENCH_SIZE));
+    debug_write(conv_time(benchmark_mult_array(), HWOP_BENCH_SIZE));
+    debug_write(conv_time(benchmark_divmod_blocking(), HWOP_BENCH_SIZE));
+    debug_write(conv_time(benchmark_divmod_array(), HWOP_BENCH_SIZE));
     debug_write(conv_time(benchmark_bitwise_shift(), ITER_SOFTLIB));
     //   2µs
     debug_write(conv_time(benchmark_conversion(), ITER_SOFTLIB));
     //  70µs
+
+    // Float-Durchsatz in Operationen pro Sekunde: add, mul, div
+    debug_write(ops_per_sec(FLOAT_BENCH_ITER, benchmark_float_ops(__addsf3)));
+    debug_write(ops_per_sec(FLOAT_BENCH_ITER, benchmark_float_ops(__mulsf3)));
+    debug_write(ops_per_sec(FLOAT_BENCH_ITER, benchmark_float_ops(__divsf3)));
+
+    // Festkomma gegen Float in Operationen pro Sekunde, jeweils Q16.16 und float:
+    // add, sub, mul, div, sqrt, sin
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_ops(q16_add)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_float_ops(__addsf3)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_ops(q16_sub)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_float_ops(__subsf3)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_ops(q16_mul)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_float_ops(__mulsf3)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_ops(q16_div)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_float_ops(__divsf3)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_func(q16_sqrt)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_float_func(float_sqrt_newton)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_func(q16_sin)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_float_func(float_sin_taylor)));
+    // Ohne Float-Gegenstück: atan2, exp2, log2
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_ops(q16_atan2)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_func(q16_exp2)));
+    debug_write(ops_per_sec(FIX_BENCH_ITER, benchmark_q16_func(q16_log2)));
+
+    // memcpy/memset/memmove mit MEM_BENCH_SIZE Bytes, Ausgabe in 1/100 Byte/µs
+    for (uint32_t i = 0; i < MEM_BENCH_SIZE + 8; i++)
+    {
+        mem_bench_src[i] = (uint8_t)i;
+    }
+    // Ausgerichtet: byteweise Referenz, memcpy, memcpy_asm
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy_bytewise, 0, 0)));
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy, 0, 0)));
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy_asm, 0, 0)));
+    // Gleich verschoben (Prolog/Epilog): memcpy, memcpy_asm
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy, 3, 3)));
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy_asm, 3, 3)));
+    // Unterschiedlich ausgerichtet (Shift-Pfad): byteweise Referenz, memcpy
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy_bytewise, 0, 1)));
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memcpy(memcpy, 0, 1)));
+    // memset: memset, memset_asm
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memset(memset, 0)));
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memset(memset_asm, 0)));
+    // Überlappend: memmove rückwärts (wortweise), memmove rückwärts (byteweise)
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memmove_overlap(4, 0)));
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memmove_overlap(1, 0)));
+    // Überlappend vorwärts (memcpy-Pfad)
+    debug_write(bytes_per_us(MEM_BENCH_SIZE, benchmark_memmove_overlap(0, 4)));
+
+    // String-Funktionen mit STR_BENCH_LEN Zeichen, Ausgabe in 1/100 µs pro Byte
+    // Jeweils: byteweise Referenz, SWAR-Variante
+    debug_write(us_per_byte(benchmark_strlen(strlen_bytewise), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strlen(strlen), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strcmp(strcmp_bytewise, str_bench_b), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strcmp(strcmp, str_bench_b), STR_BENCH_LEN));
+    // strcmp mit unterschiedlich ausgerichteten Strings (Shift-Pfad)
+    strcpy_bytewise(str_bench_dst + 1, str_bench_a);
+    debug_write(us_per_byte(benchmark_strcmp(strcmp_bytewise, str_bench_dst + 1), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strcmp(strcmp, str_bench_dst + 1), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strncmp(strncmp_bytewise), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strncmp(strncmp), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strcpy(strcpy_bytewise, 0), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strcpy(strcpy, 0), STR_BENCH_LEN));
+    debug_write(us_per_byte(benchmark_strcpy(strcpy, 1), STR_BENCH_LEN));
+
+    // SPI-Lesen mit SPI_BENCH_SIZE Bytes bei schnellstem Takt, Ausgabe in 1/100 Byte/µs
+    // Byteweise Referenz (ein Token), spi_read_buffer (Token-Pipeline)
+    spi_enable();
+    spi_automatic_cs(1);
+    spi_set_clock_divider(0);
+    debug_write(bytes_per_us(SPI_BENCH_SIZE, benchmark_spi_read(spi_read_bytewise)));
+    debug_write(bytes_per_us(SPI_BENCH_SIZE, benchmark_spi_read(spi_read_buffer)));
+
     while(1);
 }
@@ -0,0 +1,159 @@
+#include "wgrhal.h"
+
+// Exponenten-Test für __divsf3
+//
+// Für jedes Paar von Exponenten (0..255 x 0..255, also auch Subnormale,
+// Unendlich und NaN) werden MANTISSAS_PER_PAIR zufällige Mantissen mit
+// zufälligem Vorzeichen dividiert und mit divsf3_reference verglichen.
+// Die Referenz ist die bisherige Implementierung (64-Bit-Ganzzahldivision),
+// ergänzt um den Divisionsrest im Sticky-Bit und normalisierte subnormale
+// Operanden, damit sie korrekt nach IEEE 754 rundet.
+//
+// Ausgabe über debug_write:
+//   je Fehler (höchstens MAX_REPORTS): 0xBAD0BAD0, a, b, Ergebnis, Referenz
+//   am Ende: 0xD1D1D1D1, Anzahl Fälle, Anzahl Fehler
+
+#define MANTISSAS_PER_PAIR 4
+#define MAX_REPORTS 16
+#define RANDOM_SEED 0x12345678
+
+typedef union
+{
+    float f;
+    uint32_t i;
+} float_bits;
+
+static uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static uint32_t is_nan(uint32_t x)
+{
+    return ((x >> 23) & 0xFF) == 0xFF && (x & 0x7FFFFF);
+}
+
+static uint32_t divsf3_reference(uint32_t a, uint32_t b)
+{
+    uint32_t sign = (a ^ b) & 0x80000000;
+    int32_t exp_a = (a >> 23) & 0xFF;
+    int32_t exp_b = (b >> 23) & 0xFF;
+    uint32_t mant_a = a & 0x7FFFFF;
+    uint32_t mant_b = b & 0x7FFFFF;
+
+    if (is_nan(a) || is_nan(b))
+        return 0x7FC00000;
+    if (exp_a == 0xFF)
+        return (exp_b == 0xFF) ? 0x7FC00000 : (sign | 0x7F800000);
+    if (exp_b == 0xFF)
+        return sign;
+    if ((b & 0x7FFFFFFF) == 0)
+        return ((a & 0x7FFFFFFF) == 0) ? 0x7FC00000 : (sign | 0x7F800000);
+    if ((a & 0x7FFFFFFF) == 0)
+        return sign;
+
+    if (exp_a == 0)
+    {
+        exp_a = 1;
+        while (!(mant_a & (1u << 23)))
+        {
+            mant_a <<= 1;
+            exp_a--;
+        }
+    }
+    else
+        mant_a |= 1u << 23;
+    if (exp_b == 0)
+    {
+        exp_b = 1;
+        while (!(mant_b & (1u << 23)))
+        {
+            mant_b <<= 1;
+            exp_b--;
+        }
+    }
+    else
+        mant_b |= 1u << 23;
+
+    // Quotient mit 24 Bit Mantisse, einem Rundungsbit und 8 weiteren Bit
+    uint64_t dividend = (uint64_t)mant_a << 32;
+    uint64_t quotient = dividend / mant_b;
+    uint32_t sticky = (dividend % mant_b) != 0;
+    int32_t exp_result = exp_a - exp_b + 127;
+    if (quotient < (1ULL << 32))
+    {
+        quotient <<= 1;
+        exp_result--;
+    }
+    sticky |= (quotient & 0xFF) != 0;
+    uint32_t q = (uint32_t)(quotient >> 8);
+
+    if (exp_result >= 255)
+        return sign | 0x7F800000;
+    if (exp_result <= 0)
+    {
+        uint32_t shift = 1 - exp_result;
+        if (shift > 26)
+            shift = 26;
+        sticky |= (q & ((1u << shift) - 1)) != 0;
+        q >>= shift;
+        exp_result = 0;
+    }
+    uint32_t mant = q >> 1;
+    if ((q & 1) && (sticky || (mant & 1)))
+        mant++;
+    if (exp_result == 0)
+        return sign | mant;
+    return (sign | ((uint32_t)(exp_result - 1) << 23)) + mant;
+}
+
+int main()
+{
+    uint32_t state = RANDOM_SEED;
+    uint32_t cases = 0;
+    uint32_t errors = 0;
+
+    for (uint32_t exp_a = 0; exp_a < 256; exp_a++)
+    {
+        for (uint32_t exp_b = 0; exp_b < 256; exp_b++)
+        {
+            for (uint32_t k = 0; k < MANTISSAS_PER_PAIR; k++)
+            {
+                uint32_t ra = xorshift32(&state);
+                uint32_t rb = xorshift32(&state);
+                float_bits a = {.i = (ra & 0x80000000) | (exp_a << 23) | (ra & 0x7FFFFF)};
+                float_bits b = {.i = (rb & 0x80000000) | (exp_b << 23) | (rb & 0x7FFFFF)};
+                float_bits r;
+                r.f = a.f / b.f;
+                uint32_t expected = divsf3_reference(a.i, b.i);
+                cases++;
+
+                if (is_nan(r.i) && is_nan(expected))
+                    continue;
+                if (r.i != expected)
+                {
+                    if (errors < MAX_REPORTS)
+                    {
+                        debug_write(0xBAD0BAD0);
+                        debug_write(a.i);
+                        debug_write(b.i);
+                        debug_write(r.i);
+                        debug_write(expected);
+                    }
+                    errors++;
+                }
+            }
+        }
+    }
+
+    debug_write(0xD1D1D1D1);
+    debug_write(cases);
+    debug_write(errors);
+
+    while (1);
+}
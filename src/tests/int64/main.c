@@ -0,0 +1,155 @@
+#include "wgrhal.h"
+
+// Zufallstest für __muldi3, __udivdi3, __umoddi3, __divdi3 und __moddi3
+//
+// Die Operanden bestehen aus zwei xorshift32-Wörtern, die zufällig gekürzt
+// werden, damit alle Pfade vorkommen: beide Operanden in 32 Bit, 32-Bit-
+// Divisor mit 64-Bit-Dividend, Divisor mit mehr als 32 Bit und Dividend
+// kleiner als Divisor. Die Referenzen arbeiten bitweise und verwenden nur
+// 64-Bit-Addition, -Subtraktion, -Vergleiche und Shifts um eine Stelle.
+//
+// Ausgabe über debug_write:
+//   je Fehler (höchstens MAX_REPORTS): 0xBAD0BAD0, Operation, a (hi, lo), b (hi, lo)
+//   am Ende: 0xD1D1D1D1, Anzahl Fälle, Anzahl Fehler
+
+#define CASES 4096
+#define MAX_REPORTS 16
+#define RANDOM_SEED 0x12345678
+
+#define OP_MUL 1
+#define OP_UDIV 2
+#define OP_UMOD 3
+#define OP_DIV 4
+#define OP_MOD 5
+
+static uint32_t errors = 0;
+
+static uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static uint64_t random_operand(uint32_t *state)
+{
+    uint32_t hi = xorshift32(state);
+    uint32_t lo = xorshift32(state);
+    uint32_t sel = xorshift32(state);
+
+    // Je nach Auswahl oberes Wort löschen, Operand kürzen oder voll lassen
+    switch (sel & 3)
+    {
+    case 0:
+        hi = 0;
+        lo >>= (sel >> 8) & 31;
+        break;
+    case 1:
+        hi >>= (sel >> 8) & 31;
+        break;
+    case 2:
+        hi = (sel & 0x100) ? 0xFFFFFFFF : 0;
+        break;
+    default:
+        break;
+    }
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static uint64_t mul_reference(uint64_t a, uint64_t b)
+{
+    uint64_t result = 0;
+    while (b)
+    {
+        if (b & 1)
+            result += a;
+        a <<= 1;
+        b >>= 1;
+    }
+    return result;
+}
+
+static uint64_t divmod_reference(uint64_t n, uint64_t d, uint64_t *rem)
+{
+    uint64_t q = 0;
+    uint64_t r = 0;
+
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        uint32_t carry = (uint32_t)(r >> 63);
+        r = (r << 1) | (n >> 63);
+        n <<= 1;
+        q <<= 1;
+        if (carry || r >= d)
+        {
+            r -= d;
+            q |= 1;
+        }
+    }
+    *rem = r;
+    return q;
+}
+
+static void check(uint32_t op, uint64_t a, uint64_t b, uint64_t result, uint64_t expected)
+{
+    if (result == expected)
+        return;
+
+    if (errors < MAX_REPORTS)
+    {
+        debug_write(0xBAD0BAD0);
+        debug_write(op);
+        debug_write((uint32_t)(a >> 32));
+        debug_write((uint32_t)a);
+        debug_write((uint32_t)(b >> 32));
+        debug_write((uint32_t)b);
+    }
+    errors++;
+}
+
+int main()
+{
+    uint32_t state = RANDOM_SEED;
+    uint32_t cases = 0;
+
+    for (uint32_t i = 0; i < CASES; i++)
+    {
+        volatile uint64_t a = random_operand(&state);
+        volatile uint64_t b = random_operand(&state);
+        uint64_t rem;
+        uint64_t quot;
+
+        check(OP_MUL, a, b, a * b, mul_reference(a, b));
+        cases++;
+
+        if (b == 0)
+            continue;
+
+        quot = divmod_reference(a, b, &rem);
+        check(OP_UDIV, a, b, a / b, quot);
+        check(OP_UMOD, a, b, a % b, rem);
+
+        // Vorzeichenbehaftet über die Beträge, Rest mit dem Vorzeichen des Dividenden
+        int64_t sa = (int64_t)a;
+        int64_t sb = (int64_t)b;
+        uint64_t ua = (sa < 0) ? ~(uint64_t)sa + 1 : (uint64_t)sa;
+        uint64_t ub = (sb < 0) ? ~(uint64_t)sb + 1 : (uint64_t)sb;
+        quot = divmod_reference(ua, ub, &rem);
+        if ((sa < 0) != (sb < 0))
+            quot = ~quot + 1;
+        if (sa < 0)
+            rem = ~rem + 1;
+        check(OP_DIV, a, b, (uint64_t)(sa / sb), quot);
+        check(OP_MOD, a, b, (uint64_t)(sa % sb), rem);
+        cases += 4;
+    }
+
+    debug_write(0xD1D1D1D1);
+    debug_write(cases);
+    debug_write(errors);
+
+    while (1);
+}